@@ -1,11 +1,24 @@
 #ifndef ZTCPP_ZTCPP_HPP
 #define ZTCPP_ZTCPP_HPP
 
+#include <ZTCpp/Buffer_pool.hpp>
+#include <ZTCpp/Buffered_writer.hpp>
+#include <ZTCpp/Coroutines.hpp>
 #include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Endpoint.hpp>
 #include <ZTCpp/Events.hpp>
+#include <ZTCpp/File_transfer.hpp>
+#include <ZTCpp/Framed_stream.hpp>
 #include <ZTCpp/Ip_address.hpp>
+#include <ZTCpp/Metrics.hpp>
+#include <ZTCpp/Pacer.hpp>
+#include <ZTCpp/Poller.hpp>
+#include <ZTCpp/Reactor.hpp>
+#include <ZTCpp/Reliable_channel.hpp>
 #include <ZTCpp/Result.hpp>
 #include <ZTCpp/Service.hpp>
 #include <ZTCpp/Socket.hpp>
+#include <ZTCpp/Tcp_server.hpp>
+#include <ZTCpp/Tracing.hpp>
 
 #endif // !ZTCPP_ZTCPP_HPP
\ No newline at end of file
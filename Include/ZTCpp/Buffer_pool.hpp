@@ -0,0 +1,107 @@
+#ifndef ZTCPP_BUFFER_POOL_HPP
+#define ZTCPP_BUFFER_POOL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace detail {
+struct BufferSlab;
+class BufferPoolState;
+} // namespace detail
+
+//! Reference-counted handle to a fixed-size slab of memory obtained from a
+//! BufferPool. Copying a Buffer doesn't copy the data - all copies refer to the
+//! same slab, which goes back to its pool once the last handle is destroyed.
+//! Handles can safely be copied and destroyed from multiple threads at once
+//! (the slab contents themselves are not synchronized in any way, though).
+class ZTCPP_API Buffer {
+public:
+  //! Creates an invalid (empty) handle.
+  Buffer();
+
+  Buffer(const Buffer& aOther);
+  Buffer& operator=(const Buffer& aOther);
+
+  Buffer(Buffer&& aOther) noexcept;
+  Buffer& operator=(Buffer&& aOther) noexcept;
+
+  ~Buffer();
+
+  //! Returns true if the handle refers to a slab.
+  bool isValid() const;
+
+  //! Pointer to the start of the slab (nullptr for an invalid handle).
+  void* getData();
+  const void* getData() const;
+
+  //! Number of valid bytes at the start of the slab (for example, the number of
+  //! bytes written into it by Socket::receive()).
+  std::size_t getSize() const;
+
+  //! Set the number of valid bytes. Must not be larger than getCapacity().
+  void setSize(std::size_t aSize);
+
+  //! Size of the slab.
+  std::size_t getCapacity() const;
+
+  //! Number of handles which currently refer to the same slab.
+  std::size_t getReferenceCount() const;
+
+private:
+  explicit Buffer(detail::BufferSlab* aSlab);
+
+  detail::BufferSlab* _slab;
+
+  friend class BufferPool;
+};
+
+//! Thread-safe pool of equally sized memory slabs, handed out as Buffer objects.
+//! After the pool has warmed up, acquiring and releasing buffers doesn't allocate.
+//! A pool may be destroyed while some of its buffers are still alive - the
+//! remaining slabs are freed once their last handle is gone.
+class ZTCPP_API BufferPool {
+public:
+  //! ZeroTier's default virtual network MTU; slabs of this size can hold any
+  //! datagram sent over a network with the default configuration.
+  static constexpr std::size_t DEFAULT_SLAB_BYTE_SIZE = 2800;
+
+  //! Creates a pool with aInitialSlabCount slabs allocated up front. The pool can
+  //! grow up to aMaxSlabCount slabs (0 means no limit).
+  //! Use NetworkDetails::getMaximumTransissionUnit() to size the slabs for a
+  //! specific network.
+  explicit BufferPool(std::size_t aSlabByteSize = DEFAULT_SLAB_BYTE_SIZE,
+                      std::size_t aInitialSlabCount = 0,
+                      std::size_t aMaxSlabCount = 0);
+
+  //! Copying and moving is unsupported
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  ~BufferPool();
+
+  //! Get a free buffer (with size 0). Allocates a new slab if no free slabs are
+  //! available, unless the pool has reached its maximum size.
+  //! On failure, can result in: RuntimeError (pool exhausted).
+  Result<Buffer> acquire();
+
+  //! Size of each slab in this pool.
+  std::size_t getSlabByteSize() const;
+
+  //! Number of slabs that are not currently in use.
+  std::size_t getAvailableSlabCount() const;
+
+  //! Total number of slabs allocated by this pool (in use or not).
+  std::size_t getTotalSlabCount() const;
+
+private:
+  detail::BufferPoolState* _state;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_BUFFER_POOL_HPP
@@ -0,0 +1,79 @@
+#ifndef ZTCPP_BUFFERED_WRITER_HPP
+#define ZTCPP_BUFFERED_WRITER_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Gathers many small writes to a Stream (TCP) socket into a single contiguous
+//! buffer, which is then sent with as few calls into libzt as possible (and thus
+//! in as few TCP segments as possible). The buffer is sent:
+//!   - when flush() is called,
+//!   - when it reaches the flush threshold,
+//!   - when flushIfDue() is called after the oldest buffered byte has waited for
+//!     longer than the maximum flush delay (unless corked).
+//! The BufferedWriter doesn't own the socket; the socket must outlive it and
+//! should not be written to directly while there is buffered data.
+//! Not thread-safe.
+class ZTCPP_API BufferedWriter {
+public:
+  explicit BufferedWriter(Socket& aSocket,
+                          std::size_t aFlushThreshold = 16 * 1024,
+                          std::chrono::milliseconds aMaxFlushDelay = std::chrono::milliseconds{5});
+
+  //! Transfers ownership of another writer to this writer
+  BufferedWriter(BufferedWriter&&);
+  BufferedWriter& operator=(BufferedWriter&&);
+
+  //! Copying is unsupported
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  //! Note: does NOT flush (flushing could fail or block). Call flush() first.
+  ~BufferedWriter();
+
+  //! Append data to the buffer. If this makes the buffer reach the flush
+  //! threshold, the buffer is flushed (which can block). Writes that are larger
+  //! than the threshold bypass the buffer (after flushing what was buffered).
+  //! Once data is buffered, write() succeeds: if the threshold flush fails, the
+  //! unsent data stays buffered and the error is returned by the next flush()
+  //! or flushIfDue() instead. An error from write() means aData was not buffered
+  //! (though a write that bypasses the buffer may have been partially sent).
+  EmptyResult write(const void* aData, std::size_t aDataByteSize);
+
+  //! Send all buffered data. Blocks until everything is sent or aDeadline passes.
+  EmptyResult flush(Deadline aDeadline = NO_DEADLINE);
+
+  //! Flush if the maximum flush delay has passed since the oldest buffered byte
+  //! was written (does nothing while corked). Call this periodically, for example
+  //! from your event loop.
+  EmptyResult flushIfDue();
+
+  //! How long until flushIfDue() will flush; use it to bound your poll timeout.
+  //! Returns a negative value if there's nothing to flush (or while corked), and
+  //! zero if a flush is already due.
+  std::chrono::milliseconds getTimeUntilFlushDue() const;
+
+  //! While corked, the maximum flush delay doesn't apply: data is only sent when
+  //! the threshold is reached or on an explicit flush(). Uncorking flushes the
+  //! buffer (much like TCP_CORK, but in user space).
+  EmptyResult setCorked(bool aCorked);
+  bool isCorked() const;
+
+  //! Number of bytes waiting to be sent.
+  std::size_t getBufferedByteSize() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_BUFFERED_WRITER_HPP
@@ -0,0 +1,293 @@
+#ifndef ZTCPP_COROUTINES_HPP
+#define ZTCPP_COROUTINES_HPP
+
+#include <ZTCpp/Definitions.hpp>
+
+// The coroutine layer is header-only and only available when compiling as C++20
+// or newer (the library itself can still be built as C++17).
+#if defined(_MSVC_LANG)
+  #define ZTCPP_CPLUSPLUS _MSVC_LANG
+#else
+  #define ZTCPP_CPLUSPLUS __cplusplus
+#endif
+
+#if ZTCPP_CPLUSPLUS >= 202002L && defined(__has_include)
+  #if __has_include(<coroutine>)
+    #define ZTCPP_HAS_COROUTINES 1
+  #endif
+#endif
+
+#undef ZTCPP_CPLUSPLUS
+
+#ifdef ZTCPP_HAS_COROUTINES
+
+#include <ZTCpp/Ip_address.hpp>
+#include <ZTCpp/Reactor.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Return type for coroutines which use AsyncSocket. The coroutine starts running
+//! immediately when called and is detached: it cleans up after itself once it
+//! finishes. Exceptions escaping the coroutine call std::terminate().
+class CoroutineTask {
+public:
+  struct promise_type {
+    CoroutineTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+namespace detail {
+
+//! Awaitable which runs aOperation right away and, if it would block, suspends
+//! the awaiting coroutine until the reactor reports the socket as ready and
+//! aOperation finally completes (either successfully or with an error).
+//! If aSetupError is not null, aOperation isn't run at all and the awaiting
+//! coroutine gets a copy of aSetupError instead.
+template <class taResult, class taOperation>
+class SocketAwaitable {
+public:
+  SocketAwaitable(Reactor& aReactor,
+                  Socket& aSocket,
+                  std::shared_ptr<const ErrorReport> aSetupError,
+                  bool aWaitForSend,
+                  taOperation aOperation)
+    : _reactor{aReactor}
+    , _socket{aSocket}
+    , _setupError{std::move(aSetupError)}
+    , _waitForSend{aWaitForSend}
+    , _operation{std::move(aOperation)}
+  {
+  }
+
+  bool await_ready() {
+    if (_setupError) {
+      _result.emplace(std::make_unique<ErrorReport>(*_setupError));
+      return true;
+    }
+    _result.emplace(_operation());
+    return !_result->wouldBlock();
+  }
+
+  void await_suspend(std::coroutine_handle<> aHandle) {
+    _handle = aHandle;
+    auto handler = [this](Socket&, int) {
+      _result.emplace(_operation());
+      if (_result->wouldBlock()) {
+        return; // Spurious wake-up; keep waiting
+      }
+      unsetHandler();
+      _handle.resume();
+    };
+    const auto res = _waitForSend ? _reactor.setWriteHandler(_socket, handler)
+                                  : _reactor.setReadHandler(_socket, handler);
+    if (!res) {
+      // Couldn't register with the reactor; report that instead of hanging forever
+      _result.emplace(std::make_unique<ErrorReport>(res.getError()));
+      _reactor.addTimer(std::chrono::milliseconds{0}, [handle = _handle]() { handle.resume(); });
+    }
+  }
+
+  taResult await_resume() {
+    return std::move(*_result);
+  }
+
+private:
+  void unsetHandler() {
+    if (_waitForSend) {
+      (void)_reactor.setWriteHandler(_socket, nullptr);
+    }
+    else {
+      (void)_reactor.setReadHandler(_socket, nullptr);
+    }
+  }
+
+  Reactor& _reactor;
+  Socket& _socket;
+  std::shared_ptr<const ErrorReport> _setupError;
+  bool _waitForSend;
+  taOperation _operation;
+  std::optional<taResult> _result;
+  std::coroutine_handle<> _handle;
+};
+
+template <class taResult, class taOperation>
+SocketAwaitable<taResult, taOperation> MakeSocketAwaitable(
+    Reactor& aReactor,
+    Socket& aSocket,
+    std::shared_ptr<const ErrorReport> aSetupError,
+    bool aWaitForSend,
+    taOperation aOperation) {
+  return {aReactor, aSocket, std::move(aSetupError), aWaitForSend, std::move(aOperation)};
+}
+
+} // namespace detail
+
+//! Awaitable which resumes the awaiting coroutine after the given duration,
+//! without blocking the reactor.
+class SleepAwaitable {
+public:
+  SleepAwaitable(Reactor& aReactor, std::chrono::milliseconds aDuration)
+    : _reactor{aReactor}
+    , _duration{aDuration}
+  {
+  }
+
+  bool await_ready() const noexcept {
+    return _duration.count() <= 0;
+  }
+
+  void await_suspend(std::coroutine_handle<> aHandle) {
+    _reactor.addTimer(_duration, [aHandle]() { aHandle.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+private:
+  Reactor& _reactor;
+  std::chrono::milliseconds _duration;
+};
+
+//! Coroutine front-end for a Socket: instead of blocking the thread, operations
+//! suspend the calling coroutine until the socket is ready, while the Reactor
+//! (typically running in Reactor::run() on the same thread) serves any number of
+//! other sockets. Example:
+//!
+//!   CoroutineTask Echo(zt::AsyncSocket aSocket) {
+//!     char buf[1024];
+//!     for (;;) {
+//!       auto res = co_await aSocket.asyncReceive(buf, sizeof(buf));
+//!       if (!res) co_return;
+//!       co_await aSocket.asyncSend(buf, *res);
+//!     }
+//!   }
+//!
+//! Only one operation of each direction (receive/accept vs. send/connect) may
+//! be pending on a socket at a time. The Socket and the Reactor must outlive any
+//! pending operation, and so must the AsyncSocket object.
+class AsyncSocket {
+public:
+  //! Note: puts aSocket into non-blocking mode. If that fails, every operation
+  //! fails with the same error (see getSetupError()).
+  AsyncSocket(Socket& aSocket, Reactor& aReactor)
+    : _socket{&aSocket}
+    , _reactor{&aReactor}
+  {
+    auto res = _socket->setNonBlocking(true);
+    if (!res) {
+      _setupError = std::make_shared<const ErrorReport>(std::move(res.getError()));
+    }
+  }
+
+  //! Return the error which prevented aSocket from being put into non-blocking
+  //! mode, or nullptr if there was none (and the AsyncSocket is usable).
+  const ErrorReport* getSetupError() const {
+    return _setupError.get();
+  }
+
+  Socket& getSocket() const {
+    return *_socket;
+  }
+
+  Reactor& getReactor() const {
+    return *_reactor;
+  }
+
+  //! co_await-ing this yields a Result<std::size_t> (see Socket::receive()).
+  auto asyncReceive(void* aDestinationBuffer, std::size_t aDestinationBufferByteSize) {
+    Socket* socket = _socket;
+    return detail::MakeSocketAwaitable<Result<std::size_t>>(
+      *_reactor, *_socket, _setupError, false,
+      [=]() { return socket->receive(aDestinationBuffer, aDestinationBufferByteSize); });
+  }
+
+  //! co_await-ing this yields a Result<std::size_t> (see Socket::receiveFrom()).
+  auto asyncReceiveFrom(void* aDestinationBuffer,
+                        std::size_t aDestinationBufferByteSize,
+                        IpAddress& aSenderAddress,
+                        uint16_t& aSenderPort) {
+    Socket* socket = _socket;
+    return detail::MakeSocketAwaitable<Result<std::size_t>>(
+      *_reactor, *_socket, _setupError, false,
+      [=, &aSenderAddress, &aSenderPort]() {
+        return socket->receiveFrom(aDestinationBuffer, aDestinationBufferByteSize,
+                                   aSenderAddress, aSenderPort);
+      });
+  }
+
+  //! co_await-ing this yields a Result<std::size_t> (see Socket::send()).
+  auto asyncSend(const void* aData, std::size_t aDataByteSize) {
+    Socket* socket = _socket;
+    return detail::MakeSocketAwaitable<Result<std::size_t>>(
+      *_reactor, *_socket, _setupError, true,
+      [=]() { return socket->send(aData, aDataByteSize); });
+  }
+
+  //! co_await-ing this yields a Result<std::size_t> (see Socket::sendTo()).
+  auto asyncSendTo(const void* aData,
+                   std::size_t aDataByteSize,
+                   const IpAddress& aRemoteIpAddress,
+                   uint16_t aRemotePortInHostOrder) {
+    Socket* socket = _socket;
+    return detail::MakeSocketAwaitable<Result<std::size_t>>(
+      *_reactor, *_socket, _setupError, true,
+      [=]() {
+        return socket->sendTo(aData, aDataByteSize, aRemoteIpAddress, aRemotePortInHostOrder);
+      });
+  }
+
+  //! co_await-ing this yields a Result<Socket> (see Socket::accept()). The accepted
+  //! socket is left in blocking mode; wrap it into an AsyncSocket to use it with
+  //! coroutines.
+  auto asyncAccept() {
+    Socket* socket = _socket;
+    return detail::MakeSocketAwaitable<Result<Socket>>(
+      *_reactor, *_socket, _setupError, false,
+      [=]() { return socket->accept(); });
+  }
+
+  //! co_await-ing this yields an EmptyResult (see Socket::connect()).
+  auto asyncConnect(const IpAddress& aRemoteIpAddress, uint16_t aRemotePortInHostOrder) {
+    Socket* socket = _socket;
+    bool started = false;
+    return detail::MakeSocketAwaitable<EmptyResult>(
+      *_reactor, *_socket, _setupError, true,
+      [=]() mutable -> EmptyResult {
+        if (!started) {
+          started = true;
+          return socket->connect(aRemoteIpAddress, aRemotePortInHostOrder);
+        }
+        // The socket became writable, so the connection attempt has finished
+        return socket->finishConnect();
+      });
+  }
+
+  //! co_await-ing this suspends the coroutine for aDuration.
+  SleepAwaitable asyncSleep(std::chrono::milliseconds aDuration) {
+    return {*_reactor, aDuration};
+  }
+
+private:
+  Socket* _socket;
+  Reactor* _reactor;
+  std::shared_ptr<const ErrorReport> _setupError; // Shared by copies of this object
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // ZTCPP_HAS_COROUTINES
+
+#endif // !ZTCPP_COROUTINES_HPP
@@ -0,0 +1,61 @@
+#ifndef ZTCPP_ENDPOINT_HPP
+#define ZTCPP_ENDPOINT_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Ip_address.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Internal implementation details - don't use these!
+namespace detail {
+struct EndpointAccess;
+} // namespace detail
+
+//! An IP address + port pair. The matching zts_sockaddr_in/zts_sockaddr_in6 is
+//! encoded once, when the endpoint is created, so an endpoint which is sent to
+//! repeatedly (see Socket::sendTo()) doesn't need to be re-encoded every time.
+class ZTCPP_API Endpoint {
+public:
+  //! Constructs an invalid Endpoint.
+  Endpoint();
+
+  //! Constructs an endpoint from an address and a port. If the address is
+  //! invalid, so is the endpoint.
+  Endpoint(const IpAddress& aIpAddress, std::uint16_t aPortInHostOrder);
+
+  //! Parses "a.b.c.d:port" (IPv4) or "[address]:port" (IPv6). Returns an invalid
+  //! endpoint if the string is malformed.
+  static Endpoint fromString(const char* aString);
+  static Endpoint fromString(const std::string& aString);
+
+  bool isValid() const;
+  const IpAddress& getIpAddress() const;
+  std::uint16_t getPort() const;
+
+  //! Formats the endpoint the same way fromString() expects it.
+  std::string toString() const;
+
+  ZTCPP_API friend bool operator==(const Endpoint& aLeft, const Endpoint& aRight);
+  ZTCPP_API friend bool operator!=(const Endpoint& aLeft, const Endpoint& aRight);
+  ZTCPP_API friend std::ostream& operator<<(std::ostream& aOstream, const Endpoint& aEndpoint);
+
+private:
+  //! Large enough for a zts_sockaddr_in6 (Endpoint.cpp static_asserts this).
+  static constexpr std::size_t SOCKADDR_STORAGE_SIZE = 32;
+
+  IpAddress _ipAddress;
+  alignas(4) unsigned char _sockaddr[SOCKADDR_STORAGE_SIZE];
+  std::uint32_t _sockaddrLength; // 0 if the endpoint is invalid
+  std::uint16_t _port;
+
+  friend struct detail::EndpointAccess;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_ENDPOINT_HPP
@@ -0,0 +1,70 @@
+#ifndef ZTCPP_FILE_TRANSFER_HPP
+#define ZTCPP_FILE_TRANSFER_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Reported to a FileTransferProgressCallback after every chunk.
+struct FileTransferProgress {
+  uint64_t bytesTransferred; //! By this call so far
+  uint64_t totalByteSize;    //! To be transferred by this call (0 if not known in advance)
+  uint64_t fileOffset;       //! Offset in the file just after the last byte transferred;
+                             //! pass it as aOffset to resume an interrupted transfer
+};
+
+//! Return false to cancel the transfer (which then fails with a RuntimeError).
+using FileTransferProgressCallback = std::function<bool(const FileTransferProgress&)>;
+
+//! Streams files through Stream (TCP) sockets straight from/into memory-mapped
+//! views of the file, without reading them into intermediate buffers first.
+//! The file is mapped in windows of a fixed size (not all at once), so files of
+//! any size can be transferred with a bounded address space footprint, and data
+//! is handed to libzt in chunks the size of the socket's send/receive buffer.
+//! No framing is added: the receiver has to know how many bytes to expect or
+//! receive until the sender shuts the connection down.
+class ZTCPP_API FileTransfer {
+public:
+  //! Used as aLength: transfer everything from aOffset to the end of the file
+  //! (when sending) or until the connection is closed (when receiving).
+  static constexpr uint64_t TO_END = std::numeric_limits<uint64_t>::max();
+
+  //! Send aLength bytes of the file at aPath, starting at aOffset.
+  //! Blocks until everything is sent or aDeadline passes (works with both
+  //! blocking and non-blocking sockets).
+  //! On success, return value = number of bytes sent
+  static Result<uint64_t> sendFile(Socket& aSocket,
+                                   const std::string& aPath,
+                                   uint64_t aOffset = 0,
+                                   uint64_t aLength = TO_END,
+                                   const FileTransferProgressCallback& aProgressCallback = {},
+                                   Deadline aDeadline = NO_DEADLINE);
+
+  //! Receive aLength bytes (or until the remote side closes the connection) and
+  //! write them into the file at aPath, starting at aOffset. The file is created
+  //! if it doesn't exist; existing contents are kept (only overwritten where new
+  //! data is written), so an interrupted transfer can be resumed from the last
+  //! reported FileTransferProgress::fileOffset. Disk space is reserved before
+  //! data is written into it, so a full disk is reported as a RuntimeError.
+  //! Blocks until done or until aDeadline passes.
+  //! On success, return value = number of bytes received
+  static Result<uint64_t> receiveToFile(Socket& aSocket,
+                                        const std::string& aPath,
+                                        uint64_t aOffset = 0,
+                                        uint64_t aLength = TO_END,
+                                        const FileTransferProgressCallback& aProgressCallback = {},
+                                        Deadline aDeadline = NO_DEADLINE);
+
+  FileTransfer() = delete;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_FILE_TRANSFER_HPP
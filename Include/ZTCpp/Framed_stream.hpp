@@ -0,0 +1,83 @@
+#ifndef ZTCPP_FRAMED_STREAM_HPP
+#define ZTCPP_FRAMED_STREAM_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <cstddef>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Non-owning view of a message received through a FramedStream.
+struct MessageView {
+  const void* data;
+  std::size_t byteSize;
+};
+
+//! Sends and receives discrete messages over a Stream (TCP) socket. Each message
+//! is preceded by a 4-byte length prefix in network byte order.
+//! On the receiving side, data is read into an internal buffer in chunks that are
+//! as large as possible, and every complete message in the buffer is handed out
+//! without further calls into libzt - a single receive can yield many messages.
+//! The FramedStream doesn't own the socket; the socket must outlive it and should
+//! not be read from directly while the FramedStream is in use.
+class ZTCPP_API FramedStream {
+public:
+  //! Size of the length prefix.
+  static constexpr std::size_t HEADER_BYTE_SIZE = 4;
+
+  //! aMaxMessageByteSize: largest message that can be sent or received (the
+  //! internal receive buffer grows up to this size plus the header).
+  //! aReceiveChunkByteSize: initial size of the receive buffer.
+  explicit FramedStream(Socket& aSocket,
+                        std::size_t aMaxMessageByteSize = 1024 * 1024,
+                        std::size_t aReceiveChunkByteSize = 64 * 1024);
+
+  //! Transfers ownsership of another stream to this stream
+  FramedStream(FramedStream&&);
+  FramedStream& operator=(FramedStream&&);
+
+  //! Copying is unsupported
+  FramedStream(const FramedStream&) = delete;
+  FramedStream& operator=(const FramedStream&) = delete;
+
+  //! Regular destructor.
+  ~FramedStream();
+
+  //! Send one message (header and payload are sent together in one call into
+  //! libzt whenever possible, which is only when there is no deadline). Empty
+  //! messages are allowed.
+  //! Blocks until the whole message is sent (even with a non-blocking socket),
+  //! or until aDeadline passes (TimeoutError). Note that after a failure, the
+  //! stream is no longer usable since the peer may have received a partial frame.
+  EmptyResult sendMessage(const void* aData,
+                          std::size_t aDataByteSize,
+                          Deadline aDeadline = NO_DEADLINE);
+
+  //! Return the next message. If a complete message is already buffered, returns
+  //! immediately; otherwise receives from the socket (which blocks, unless the
+  //! socket is non-blocking, in which case this can return WouldBlock - partial
+  //! data is kept for the next call).
+  //! The returned view points into the internal buffer and remains valid only
+  //! until the next call to receiveMessage().
+  //! A message longer than aMaxMessageByteSize results in an error, after which
+  //! the stream is no longer usable.
+  Result<MessageView> receiveMessage();
+
+  //! Returns true if a complete message is buffered (so receiveMessage() won't
+  //! need to call into libzt).
+  bool hasBufferedMessage() const;
+
+  //! Returns the socket this stream is using.
+  Socket& getSocket() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_FRAMED_STREAM_HPP
@@ -0,0 +1,54 @@
+#ifndef ZTCPP_METRICS_HPP
+#define ZTCPP_METRICS_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+
+#include <cstddef>
+#include <string>
+
+ZTCPP_NAMESPACE_BEGIN
+
+enum class MetricsFormat {
+  PrometheusText, //! Prometheus text exposition format (version 0.0.4)
+  Json
+};
+
+//! Library-wide metrics, collected all the time by every part of ZTCpp:
+//!   - ztcpp_sockets_open                     (gauge)
+//!   - ztcpp_sockets_opened_total             (counter)
+//!   - ztcpp_bytes_sent_total                 (counter)
+//!   - ztcpp_bytes_received_total             (counter)
+//!   - ztcpp_errors_total{code="..."}         (counter, by ErrorCode; WouldBlock is
+//!                                            counted once, where it originates)
+//!   - ztcpp_events_total{category="..."}     (counter, by EventCode category)
+//!   - ztcpp_node_start_duration_seconds      (histogram of LocalNode::start())
+//! Each thread updates its own shard of the counters (no locks or shared cache
+//! lines on the hot path); the shards are only added up when the metrics are
+//! written out. Counts from threads that have exited are kept.
+//! Nothing is served over the network: dump the metrics on demand (for example,
+//! periodically into a file which a scraper or exporter picks up).
+//! All functions are thread-safe.
+class ZTCPP_API Metrics {
+public:
+  //! Write the current metrics into aBuffer (no null terminator is added).
+  //! Fails with an ArgumentError (and writes nothing) if aBuffer is too small.
+  //! On success, return value = number of bytes written
+  static Result<std::size_t> write(MetricsFormat aFormat,
+                                   char* aBuffer,
+                                   std::size_t aBufferByteSize);
+
+  //! Return the current metrics as a string.
+  static std::string toString(MetricsFormat aFormat);
+
+  //! Write the current metrics into the file at aPath. The file is replaced
+  //! atomically (written under a temporary name and then renamed), so a reader
+  //! never sees a partially written file.
+  static EmptyResult writeToFile(MetricsFormat aFormat, const std::string& aPath);
+
+  Metrics() = delete;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_METRICS_HPP
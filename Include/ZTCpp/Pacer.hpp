@@ -0,0 +1,157 @@
+#ifndef ZTCPP_PACER_HPP
+#define ZTCPP_PACER_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Endpoint.hpp>
+#include <ZTCpp/Ip_address.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Sustained rate and maximum burst for a TokenBucket.
+struct PacingRate {
+  std::uint64_t bytesPerSecond = 0; //! 0 means unlimited
+  std::size_t   burstByteSize  = 0; //! How many bytes can be sent at once after being idle
+
+  static PacingRate unlimited() {
+    return {};
+  }
+
+  bool isUnlimited() const {
+    return bytesPerSecond == 0;
+  }
+};
+
+//! Classic token bucket: tokens (bytes) accumulate at the configured rate up to
+//! the burst size, and sending consumes them. A send is allowed as soon as there
+//! are enough tokens for it - or, for sends larger than the burst size, as soon
+//! as the bucket is full; the bucket then goes into debt, which delays the sends
+//! that follow, so the average rate is still honoured.
+//! Not thread-safe.
+class ZTCPP_API TokenBucket {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  //! Constructs an unlimited bucket.
+  TokenBucket();
+
+  //! Constructs a bucket with the given rate, which starts out full.
+  explicit TokenBucket(PacingRate aRate);
+
+  //! Changes the rate; the tokens accumulated so far are kept (up to the new burst size).
+  void setRate(PacingRate aRate);
+  PacingRate getRate() const;
+
+  //! Consumes aByteSize tokens and returns true if the send is allowed,
+  //! otherwise returns false and changes nothing.
+  bool tryConsume(std::size_t aByteSize, Clock::time_point aNow = Clock::now());
+
+  //! Takes away aByteSize tokens unconditionally (can go into debt).
+  void consume(std::size_t aByteSize, Clock::time_point aNow = Clock::now());
+
+  //! Returns true if a send of aByteSize bytes would be allowed right now.
+  bool isAllowed(std::size_t aByteSize, Clock::time_point aNow = Clock::now()) const;
+
+  //! How long until a send of aByteSize bytes will be allowed (zero if it already is).
+  Clock::duration getTimeUntilAllowed(std::size_t aByteSize,
+                                      Clock::time_point aNow = Clock::now()) const;
+
+  //! Returns true if the bucket holds as many tokens as it can (so forgetting it
+  //! and creating a new one later would make no difference).
+  bool isFull(Clock::time_point aNow = Clock::now()) const;
+
+private:
+  double getTokens(Clock::time_point aNow) const;
+  void refill(Clock::time_point aNow);
+  double getRequiredTokens(std::size_t aByteSize) const;
+
+  PacingRate _rate;
+  double _tokens;
+  Clock::time_point _lastRefillTime;
+};
+
+//! Paces the data sent through a socket with token buckets: one for the socket as
+//! a whole, and one for each destination IP address (peers can be given their own
+//! rates; the others share the default peer rate, each with a separate bucket).
+//! A send must be allowed by both the socket's bucket and the destination's.
+//!
+//! Sends never wait for tokens: if a send isn't allowed yet, WouldBlock is returned
+//! and nothing is sent. Use getTimeUntilAllowed() to bound your poll timeout and
+//! retry when it runs out.
+//! The Pacer doesn't own the socket; the socket must outlive it and should not be
+//! written to directly (that would bypass the pacing).
+//! Not thread-safe.
+class ZTCPP_API Pacer {
+public:
+  explicit Pacer(Socket& aSocket, PacingRate aSocketRate = PacingRate::unlimited());
+
+  //! Transfers ownership of another pacer to this pacer
+  Pacer(Pacer&&);
+  Pacer& operator=(Pacer&&);
+
+  //! Copying is unsupported
+  Pacer(const Pacer&) = delete;
+  Pacer& operator=(const Pacer&) = delete;
+
+  //! Regular destructor.
+  ~Pacer();
+
+  //! Rate for all data sent through the socket.
+  void setSocketRate(PacingRate aRate);
+  PacingRate getSocketRate() const;
+
+  //! Rate for data sent to a specific IP address (overrides the default peer rate).
+  void setPeerRate(const IpAddress& aIpAddress, PacingRate aRate);
+
+  //! Return a peer to the default peer rate.
+  void resetPeerRate(const IpAddress& aIpAddress);
+
+  //! Rate for data sent to each IP address which wasn't given its own rate.
+  void setDefaultPeerRate(PacingRate aRate);
+  PacingRate getDefaultPeerRate() const;
+
+  //! Same as Socket::send() if pacing allows it, otherwise returns WouldBlock.
+  //! The destination is the socket's remote (connected) address.
+  //! Only the bytes actually sent are charged to the buckets.
+  Result<std::size_t> send(const void* aData,
+                           std::size_t aDataByteSize,
+                           int aFlags = IoFlags::None);
+
+  //! Same as Socket::sendTo() if pacing allows it, otherwise returns WouldBlock.
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const IpAddress& aRemoteIpAddress,
+                             uint16_t aRemotePort);
+
+  //! Same as Socket::sendTo() if pacing allows it, otherwise returns WouldBlock.
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const Endpoint& aRemoteEndpoint);
+
+  //! How long until send() of aByteSize bytes will be allowed (zero if it
+  //! already is). Rounded up to whole milliseconds, so it can be used as a
+  //! poll timeout directly.
+  std::chrono::milliseconds getTimeUntilAllowed(std::size_t aByteSize) const;
+
+  //! How long until sendTo() of aByteSize bytes to aRemoteIpAddress will be
+  //! allowed (zero if it already is).
+  std::chrono::milliseconds getTimeUntilAllowed(std::size_t aByteSize,
+                                                const IpAddress& aRemoteIpAddress) const;
+
+  //! Returns the socket this pacer is sending through.
+  Socket& getSocket() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_PACER_HPP
@@ -0,0 +1,81 @@
+#ifndef ZTCPP_POLLER_HPP
+#define ZTCPP_POLLER_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Describes a socket which had events reported by Poller::wait().
+struct PollerEvent {
+  Socket* socket; //! Socket for which the events occurred
+  int events;     //! Compare with PollEventBitmask::Enum to see which events occurred
+};
+
+//! Polls any number of sockets for events with a single call into libzt.
+//! Registered sockets are kept in a contiguous array which is reused between
+//! calls to wait(), so waiting doesn't allocate once the poller has warmed up.
+//! Sockets are referred to by pointer, so a registered socket must not be moved
+//! or destroyed before it's removed from the poller.
+//! Not thread-safe.
+class ZTCPP_API Poller {
+public:
+  //! Creates an empty poller.
+  Poller();
+
+  //! Transfers ownsership of another poller to this poller
+  Poller(Poller&&);
+  Poller& operator=(Poller&&);
+
+  //! Copying is unsupported
+  Poller(const Poller&) = delete;
+  Poller& operator=(const Poller&) = delete;
+
+  //! Regular destructor.
+  ~Poller();
+
+  //! Start polling a socket for the events marked in aInterestedIn.
+  //! Fails if the socket isn't open or is already registered.
+  EmptyResult add(Socket& aSocket, PollEventBitmask::Enum aInterestedIn);
+
+  //! Change the events a registered socket is polled for.
+  //! Fails if the socket isn't registered.
+  EmptyResult modify(Socket& aSocket, PollEventBitmask::Enum aInterestedIn);
+
+  //! Stop polling a socket. Fails if the socket isn't registered.
+  //! Note: remove sockets BEFORE closing them.
+  EmptyResult remove(Socket& aSocket);
+
+  //! Returns true if the socket is registered with this poller.
+  bool contains(const Socket& aSocket) const;
+
+  //! Returns the number of registered sockets.
+  std::size_t getSocketCount() const;
+
+  //! Blocks until an event occurs on any of the registered sockets, or until
+  //! aMaxTimeToWait has passed. If aMaxTimeToWait is 0, returns immediately. If it
+  //! is negative, waits indefinitely until an event occurs.
+  //! HungUp, Error and InvalidSocket conditions are reported per socket (through
+  //! PollerEvent::events) and don't cause the whole call to fail.
+  //! On success, return value = number of sockets with events (these can then be
+  //! read through getReadyEvents()).
+  Result<std::size_t> wait(std::chrono::milliseconds aMaxTimeToWait);
+
+  //! Events reported by the last call to wait(). Invalidated by the next call to
+  //! wait() and by modifying the poller (add/modify/remove).
+  const std::vector<PollerEvent>& getReadyEvents() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_POLLER_HPP
@@ -0,0 +1,104 @@
+#ifndef ZTCPP_REACTOR_HPP
+#define ZTCPP_REACTOR_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Single-threaded event loop: dispatches socket readiness events and timers to
+//! user-provided callbacks. All registered sockets are polled with a single call
+//! into libzt (see Poller) and the wait never lasts longer than it takes for the
+//! next timer to expire.
+//! Sockets are referred to by pointer, so a registered socket must not be moved
+//! or destroyed before it's removed from the reactor. Handlers are allowed to
+//! (un)register sockets and timers, including the ones they were invoked for.
+//! Not thread-safe, except for stop().
+//! Tip: put registered sockets into non-blocking mode, so that a spurious
+//! wake-up can never make a handler block the whole loop.
+class ZTCPP_API Reactor {
+public:
+  //! Invoked when a socket becomes ready. Compare aEvents with PollEventBitmask::Enum
+  //! to see which events occurred. HungUp and Error conditions are reported to the
+  //! read handler if there is one, otherwise to the write handler.
+  using SocketHandler = std::function<void(Socket& aSocket, int aEvents)>;
+
+  //! Invoked with the result of Socket::accept() when a listening socket has a
+  //! pending connection.
+  using AcceptHandler = std::function<void(Socket& aListener, Result<Socket> aAcceptResult)>;
+
+  //! Invoked when a timer expires.
+  using TimerHandler = std::function<void()>;
+
+  //! Identifies a timer (for cancelTimer()). IDs are never reused.
+  using TimerID = std::uint64_t;
+
+  //! Creates a reactor with no sockets or timers.
+  //! aMaxIdleWaitTime: how long a single wait can last when no timer bounds it
+  //! (this is also the longest it can take for stop() to take effect).
+  explicit Reactor(std::chrono::milliseconds aMaxIdleWaitTime = std::chrono::milliseconds{50});
+
+  //! Copying and moving is unsupported
+  Reactor(const Reactor&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+
+  //! Regular destructor.
+  ~Reactor();
+
+  //! Set the handler to invoke when aSocket is ready to receive (replaces the
+  //! previous one, if any). Passing an empty handler unsets it.
+  EmptyResult setReadHandler(Socket& aSocket, SocketHandler aHandler);
+
+  //! Set the handler to invoke when aSocket is ready to send (replaces the
+  //! previous one, if any). Passing an empty handler unsets it.
+  EmptyResult setWriteHandler(Socket& aSocket, SocketHandler aHandler);
+
+  //! Set the handler to invoke when a connection is accepted on aListener, which
+  //! must be a listening Stream socket. The reactor calls accept() itself.
+  //! Replaces the read handler and vice versa. Passing an empty handler unsets it.
+  EmptyResult setAcceptHandler(Socket& aListener, AcceptHandler aHandler);
+
+  //! Unset all handlers of a socket. Does nothing if the socket isn't registered.
+  //! Note: remove sockets BEFORE closing them.
+  void removeSocket(Socket& aSocket);
+
+  //! Returns the number of sockets with at least one handler set.
+  std::size_t getSocketCount() const;
+
+  //! Invoke aHandler once, after aDelay has passed.
+  TimerID addTimer(std::chrono::milliseconds aDelay, TimerHandler aHandler);
+
+  //! Invoke aHandler every aInterval (until cancelled).
+  TimerID addPeriodicTimer(std::chrono::milliseconds aInterval, TimerHandler aHandler);
+
+  //! Cancel a timer. Returns false if no such timer is pending.
+  bool cancelTimer(TimerID aTimerID);
+
+  //! Wait for events (for at most aMaxTimeToWait, or until the next timer expires)
+  //! and dispatch them. If aMaxTimeToWait is negative, waits until there is
+  //! something to dispatch (or aMaxIdleWaitTime passes).
+  //! On failure, can result in: SocketError, ServiceError, GenericError.
+  EmptyResult runOnce(std::chrono::milliseconds aMaxTimeToWait);
+
+  //! Dispatch events until stop() is called or until an error occurs.
+  EmptyResult run();
+
+  //! Make run() return as soon as possible. Can be called from any thread,
+  //! including from handlers.
+  void stop();
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_REACTOR_HPP
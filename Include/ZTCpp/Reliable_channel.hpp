@@ -0,0 +1,152 @@
+#ifndef ZTCPP_RELIABLE_CHANNEL_HPP
+#define ZTCPP_RELIABLE_CHANNEL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Endpoint.hpp>
+#include <ZTCpp/Framed_stream.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Delivery guarantees for a message sent through a ReliableChannel.
+enum class MessageOrdering {
+  Ordered,  //! Delivered after all ordered messages sent before it
+  Unordered //! Delivered as soon as it arrives (can overtake other messages)
+};
+
+//! Reliable, message-oriented transport over a Datagram (UDP) socket, talking to
+//! a single remote endpoint. Every message is delivered exactly once; ordered
+//! messages are additionally delivered in the order in which they were sent,
+//! while unordered messages don't wait for any message lost before them.
+//!
+//! Each datagram carries one message, plus a header with a cumulative ACK and a
+//! 32-bit selective ACK bitfield (so ACKs ride along with data whenever there is
+//! data to send). Lost messages are retransmitted after a timeout derived from
+//! the measured round-trip time (RFC 6298), or sooner if later messages are
+//! acknowledged while they aren't (fast retransmit). The number of messages in
+//! flight is limited by an AIMD congestion window.
+//!
+//! The channel never blocks and has no threads of its own: call update()
+//! whenever the socket is readable and at least every getTimeUntilNextUpdate(),
+//! then collect messages with receiveMessage().
+//! The ReliableChannel doesn't own the socket; the socket must outlive it and
+//! should not be read from directly while the channel is in use (datagrams from
+//! endpoints other than the remote endpoint are discarded).
+//! Not thread-safe.
+class ZTCPP_API ReliableChannel {
+public:
+  struct Config {
+    //! Largest message that can be sent (each message must fit into a single
+    //! datagram together with the header, so keep this below the path MTU).
+    //! Capped at 65487 bytes (the largest UDP payload over IPv4 minus the header).
+    std::size_t maxMessageByteSize = 1200;
+
+    //! sendMessage() returns WouldBlock when this many messages are waiting to be
+    //! sent or acknowledged
+    std::size_t maxPendingMessages = 4096;
+
+    //! Upper limit for the congestion window (in messages)
+    std::size_t maxCongestionWindow = 256;
+
+    //! Retransmission timeout before any round-trip time was measured, and the
+    //! bounds within which the measured timeout is kept
+    std::chrono::milliseconds initialRetransmissionTimeout{500};
+    std::chrono::milliseconds minRetransmissionTimeout{30};
+    std::chrono::milliseconds maxRetransmissionTimeout{5000};
+
+    //! A message which is not acknowledged after being transmitted this many
+    //! times puts the channel into a failed state
+    unsigned maxTransmissionCount = 12;
+
+    //! How long an ACK may be delayed in the hope of sending it along with data
+    std::chrono::milliseconds ackDelay{5};
+
+    //! For testing: fraction (0.0 - 1.0) of outgoing datagrams to deliberately
+    //! drop instead of sending, and the seed for the generator which picks them
+    double simulatedLossRate = 0.0;
+    std::uint32_t simulatedLossSeed = 1;
+  };
+
+  struct Statistics {
+    std::chrono::microseconds smoothedRoundTripTime; //! 0 until measured
+    std::chrono::microseconds roundTripTimeVariation;
+    std::chrono::microseconds retransmissionTimeout;
+    double congestionWindow;      //! In messages
+    std::size_t messagesInFlight; //! Sent but not yet acknowledged
+    std::size_t messagesQueued;   //! Not yet sent (waiting for the congestion window)
+    std::uint64_t messagesSent;
+    std::uint64_t messagesReceived;
+    std::uint64_t retransmissions;
+    std::uint64_t duplicatesReceived;
+  };
+
+  //! Size of the header which precedes every message.
+  static constexpr std::size_t HEADER_BYTE_SIZE = 20;
+
+  //! Creates a channel to aRemoteEndpoint using the default Config.
+  ReliableChannel(Socket& aSocket, const Endpoint& aRemoteEndpoint);
+
+  ReliableChannel(Socket& aSocket, const Endpoint& aRemoteEndpoint, const Config& aConfig);
+
+  //! Transfers ownsership of another channel to this channel
+  ReliableChannel(ReliableChannel&&);
+  ReliableChannel& operator=(ReliableChannel&&);
+
+  //! Copying is unsupported
+  ReliableChannel(const ReliableChannel&) = delete;
+  ReliableChannel& operator=(const ReliableChannel&) = delete;
+
+  //! Regular destructor.
+  ~ReliableChannel();
+
+  //! Queue a message for reliable delivery and send it right away if the
+  //! congestion window allows. Empty messages are allowed.
+  //! Returns WouldBlock if Config::maxPendingMessages messages are already pending
+  //! (call update() to make progress), or an error if the channel has failed.
+  //! Once the message is queued, this succeeds even if sending it right away
+  //! fails; socket errors are reported by the next update().
+  EmptyResult sendMessage(const void* aData,
+                          std::size_t aDataByteSize,
+                          MessageOrdering aOrdering = MessageOrdering::Ordered);
+
+  //! Receive all datagrams that are waiting on the socket, send ACKs, retransmit
+  //! lost messages and send queued messages that now fit into the window.
+  //! Never blocks. Returns an error if the socket fails, or if a message was not
+  //! acknowledged after Config::maxTransmissionCount transmissions - in which case
+  //! the channel has failed and every further call will fail as well.
+  EmptyResult update();
+
+  //! Return the next delivered message, or WouldBlock if there is none (messages
+  //! are only received by update()). The view is valid until the next call to
+  //! receiveMessage().
+  Result<MessageView> receiveMessage();
+
+  //! Returns true if receiveMessage() would return a message.
+  bool hasReceivedMessage() const;
+
+  //! How long until update() has to be called next (even if nothing is received),
+  //! to retransmit a message or to send a delayed ACK. Returns a negative value if
+  //! there are no such timers, and zero if update() is already due.
+  std::chrono::milliseconds getTimeUntilNextUpdate() const;
+
+  //! Number of messages which were sent but not acknowledged yet, or not sent yet.
+  std::size_t getPendingMessageCount() const;
+
+  const Endpoint& getRemoteEndpoint() const;
+
+  Statistics getStatistics() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_RELIABLE_CHANNEL_HPP
@@ -17,7 +17,9 @@ struct ErrorCode {
     RuntimeError,
     ArgumentError,
     SocketError,
-    ServiceError
+    ServiceError,
+    WouldBlock,   //! Non-blocking operation could not complete immediately (see Result::wouldBlock())
+    TimeoutError  //! Operation did not complete before its deadline
   };
 };
 
@@ -30,14 +32,35 @@ struct ErrorReport {
   std::string message;
 };
 
+namespace detail {
+//! Counts an error in the library-wide metrics (see Metrics.hpp).
+ZTCPP_API void RecordErrorMetric(ErrorCode::Enum aErrorCode) noexcept;
+} // namespace detail
+
 #define ZTCPP_ERROR_REPORT(_error_code_, _message_) \
-  std::make_unique<ErrorReport>( \
+  (detail::RecordErrorMetric(ErrorCode::_error_code_), \
+   std::make_unique<ErrorReport>( \
     ErrorCode::_error_code_,  \
     std::string{"ZTCpp:"} + #_error_code_ + " - \"" + _message_ \
-    + "\" in function: " + std::string{ZTCPP_PRETTY_FUNCTION})
+    + "\" in function: " + std::string{ZTCPP_PRETTY_FUNCTION}))
 
 struct DummyResultType {};
 
+//! Marker type signifying that a non-blocking operation could not be completed
+//! immediately (the underlying call failed with EAGAIN/EWOULDBLOCK).
+struct WouldBlockType {};
+
+namespace detail {
+//! Shared error report returned by Result::getError() const for results which
+//! hold WouldBlockType.
+inline
+const ErrorReport& WouldBlockErrorReport() {
+  static const ErrorReport report{ErrorCode::WouldBlock,
+                                  "ZTCpp:WouldBlock - \"Operation would block\""};
+  return report;
+}
+} // namespace detail
+
 //! Template class that encapsulates either the result (return value) of a
 //! function call, in case of success, or an error report (as an ErrorReport
 //! object) in case of an error or failure.
@@ -45,6 +68,10 @@ struct DummyResultType {};
 //! dynamic/shared library and throwing exceptions across DLL boundaries is
 //! not recommended. Use ZTCPP_THROW_ON_ERROR() macro from the caller side
 //! or check for errors manually.
+//! A third state exists for operations on non-blocking sockets: wouldBlock()
+//! is true when the operation couldn't complete immediately. Such a result
+//! also counts as an error (hasError() is true), but creating it involves no
+//! memory allocation, so it's cheap enough to return in hot polling loops.
 template <class taResultType>
 class Result {
 public:
@@ -58,8 +85,21 @@ public:
   {
   }
 
+  Result(WouldBlockType aWouldBlock)
+    : _data(aWouldBlock)
+  {
+  }
+
   bool hasError() const {
-    return std::holds_alternative<std::unique_ptr<ErrorReport>>(_data);
+    return !std::holds_alternative<taResultType>(_data);
+  }
+
+  bool wouldBlock() const {
+    if (std::holds_alternative<WouldBlockType>(_data)) {
+      return true;
+    }
+    const auto* errorReport = std::get_if<std::unique_ptr<ErrorReport>>(&_data);
+    return (errorReport != nullptr && (*errorReport)->errorCode == ErrorCode::WouldBlock);
   }
 
   operator bool() const {
@@ -84,18 +124,26 @@ public:
     return get();
   }
 
+  //! If the result would block, the shared report is first copied into this
+  //! result (so that the caller may modify it or move from it).
   ErrorReport& getError() {
     assert(hasError());
+    if (std::holds_alternative<WouldBlockType>(_data)) {
+      _data = std::make_unique<ErrorReport>(detail::WouldBlockErrorReport());
+    }
     return *std::get<std::unique_ptr<ErrorReport>>(_data);
   }
 
   const ErrorReport& getError() const {
     assert(hasError());
+    if (std::holds_alternative<WouldBlockType>(_data)) {
+      return detail::WouldBlockErrorReport();
+    }
     return *std::get<std::unique_ptr<ErrorReport>>(_data);
   }
 
 private:
-  std::variant<taResultType, std::unique_ptr<ErrorReport>> _data;
+  std::variant<taResultType, std::unique_ptr<ErrorReport>, WouldBlockType> _data;
 };
 
 using EmptyResult = Result<DummyResultType>;
@@ -106,6 +154,13 @@ EmptyResult EmptyResultOK() {
   return {DummyResultType{}};
 }
 
+//! Function for internal use. (Returns an object which converts to any Result<>
+//! type, signifying that the operation would block).
+inline
+WouldBlockType ResultWouldBlock() {
+  return {};
+}
+
 //! Checks a Result<> object for errors. Throws an exception of type _exc_type_
 //! if _result_ hols an error.
 #define ZTCPP_THROW_ON_ERROR(_result_, _exc_type_) \
@@ -1,7 +1,9 @@
 #ifndef ZTCPP_SOCKET_HPP
 #define ZTCPP_SOCKET_HPP
 
+#include <ZTCpp/Buffer_pool.hpp>
 #include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Endpoint.hpp>
 #include <ZTCpp/Ip_address.hpp>
 #include <ZTCpp/Result.hpp>
 
@@ -9,9 +11,16 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 ZTCPP_NAMESPACE_BEGIN
 
+//! Point in time by which an operation has to complete.
+using Deadline = std::chrono::steady_clock::time_point;
+
+//! Deadline which never passes.
+constexpr Deadline NO_DEADLINE = Deadline::max();
+
 enum class SocketDomain {
   InternetProtocol_IPv4,
   InternetProtocol_IPv6
@@ -30,20 +39,96 @@ struct PollEventBitmask {
     ReadyToSend                = 2, //! Can call send() or sendTo() without blocking
     ReadyToReceivePriorityData = 4, //! Same as ReadyToReceive but for out-of-bound data
 
+    // The following are only ever reported (by Poller), never requested:
+    HungUp                     = 8,  //! Remote side of the connection hung up
+    Error                      = 16, //! An error is pending on the socket
+    InvalidSocket              = 32, //! Socket descriptor is invalid (closed?)
+
     ReadyToAccept              = ReadyToReceive, //! Can call accept() without blocking
     ReadyToReceiveAny          = ReadyToReceive | ReadyToReceivePriorityData,
     AnyEvent                   = ReadyToReceiveAny | ReadyToSend
   };
 };
 
+//! Per-call flags for send(), receive() and receiveFrom() (see below). Combine
+//! them with bitwise OR.
+struct IoFlags {
+  enum Enum {
+    None     = 0,
+    Peek     = 1, //! Receive without removing the data from the queue (MSG_PEEK)
+    DontWait = 2, //! Don't block, even if the socket is blocking (MSG_DONTWAIT)
+    WaitAll  = 4, //! Block until the whole buffer is filled (MSG_WAITALL)
+    More     = 8  //! More data is coming, hold off sending a segment (MSG_MORE)
+  };
+};
+
+//! One segment of a scattered/gathered buffer, used for sendv() (see below).
+struct ConstBufferSegment {
+  const void* data;
+  std::size_t byteSize;
+};
+
+//! One segment of a scattered/gathered buffer, used for receivev() (see below).
+struct BufferSegment {
+  void* data;
+  std::size_t byteSize;
+};
+
+//! Describes one datagram to be sent by sendToMany() (see below).
+struct OutgoingDatagram {
+  const void* data;              //! [in]  Payload
+  std::size_t dataByteSize;      //! [in]  Payload size
+  IpAddress   remoteIpAddress;   //! [in]  Destination address
+  uint16_t    remotePort;        //! [in]  Destination port (in host order)
+  std::size_t bytesSent;         //! [out] Number of bytes sent (valid only if the datagram was sent)
+};
+
+//! Describes one buffer to be filled by receiveFromMany() (see below).
+struct IncomingDatagram {
+  void*       buffer;            //! [in]  Destination buffer
+  std::size_t bufferByteSize;    //! [in]  Destination buffer size
+  std::size_t bytesReceived;     //! [out] Number of bytes written to the buffer
+  IpAddress   senderIpAddress;   //! [out] Sender's address
+  uint16_t    senderPort;        //! [out] Sender's port (in host order)
+};
+
+//! Snapshot of a socket's activity counters (see Socket::getStatistics()).
+//! Calls are counted per call into libzt, so a single sendAll() or receiveExact()
+//! can account for several of them.
+struct SocketStatistics {
+  uint64_t bytesSent;
+  uint64_t bytesReceived;
+  uint64_t sendCalls;           //! Calls which sent data (or tried to)
+  uint64_t receiveCalls;        //! Calls which received data (or tried to)
+  uint64_t partialWrites;       //! Sends which sent fewer bytes than requested
+  uint64_t wouldBlockCount;     //! Calls which failed with EAGAIN/EWOULDBLOCK
+  uint64_t socketErrors;        //! Calls which failed with ZTS_ERR_SOCKET (other than would-block)
+  uint64_t serviceErrors;       //! Calls which failed with ZTS_ERR_SERVICE
+  uint64_t argumentErrors;      //! Calls which failed with ZTS_ERR_ARG
+  uint64_t otherErrors;         //! Calls which failed in any other way
+  uint64_t connectionsAccepted;
+  std::chrono::nanoseconds timeBlocked; //! Total time spent inside libzt calls which
+                                        //! can block (send, receive, accept, connect, poll)
+};
+
+class Socket;
+struct AcceptedConnection;
+
+//! Internal implementation details - don't use these functions!
+namespace detail {
+//! Returns the libzt socket descriptor of aSocket.
+int GetSocketID(const Socket& aSocket);
+} // namespace detail
+
 class ZTCPP_API Socket {
 public:
   //! Creates an uninitialized socket.
   Socket();
 
-  //! Transfers ownsership of another socket to this socket
-  Socket(Socket&&);
-  Socket& operator=(Socket&&);
+  //! Transfers ownsership of another socket to this socket (the other socket is
+  //! left uninitialized)
+  Socket(Socket&&) noexcept;
+  Socket& operator=(Socket&&) noexcept;
 
   //! Copying is unsupported
   Socket(const Socket&) = delete;
@@ -66,6 +151,24 @@ public:
   EmptyResult connect(const IpAddress& aRemoteIpAddress,
                       uint16_t aRemotePortInHostOrder);
 
+  //! Same as connect() but gives up with a TimeoutError if the connection can't
+  //! be established by aDeadline (instead of waiting for the whole SYN retry
+  //! schedule). Internally the socket is switched to non-blocking mode for the
+  //! duration of the call. After a timeout, the socket should be closed.
+  EmptyResult connect(const IpAddress& aRemoteIpAddress,
+                      uint16_t aRemotePortInHostOrder,
+                      Deadline aDeadline);
+
+  //! Same as above, with a deadline of aTimeout from now.
+  EmptyResult connect(const IpAddress& aRemoteIpAddress,
+                      uint16_t aRemotePortInHostOrder,
+                      std::chrono::milliseconds aTimeout);
+
+  //! After connect() on a non-blocking socket returned WouldBlock and the socket
+  //! has since become writable, checks whether the connection succeeded (using
+  //! SO_ERROR; reading it clears it, so call this only once per attempt).
+  EmptyResult finishConnect();
+
   //! Set the socket in a listening state waiting for in coming connections to be
   //! accepted. The MaxQueueSize indicates how many connections can await acceptance
   //! at any a time.
@@ -78,11 +181,71 @@ public:
   //! Only works for Stream (TCP) sockets and always fails on others.
   Result<Socket> accept(); 
 
+  //! Same as accept() but also, on success, reports the peer's IP and port
+  //! through the last two arguments (obtained without any string conversions).
+  Result<Socket> accept(IpAddress& aRemoteIpAddress, uint16_t& aRemotePort);
+
+  //! Accepts pending connections until there are none left or until aMaxCount
+  //! connections have been accepted, and appends them to aConnections. Only the
+  //! first accept is allowed to block (unless the socket is non-blocking).
+  //! If the first connection could not be accepted, the error is reported; if
+  //! some connections were accepted before a failure, only the count is reported.
+  //! Only works for Stream (TCP) sockets and always fails on others.
+  //! On success, return value = number of connections accepted
+  Result<std::size_t> acceptMany(std::vector<AcceptedConnection>& aConnections,
+                                 std::size_t aMaxCount = SIZE_MAX);
+
+  //! Same as accept() but gives up with a TimeoutError if no connection is
+  //! accepted by aDeadline.
+  Result<Socket> accept(Deadline aDeadline);
+
+  //! Same as above, with a deadline of aTimeout from now.
+  Result<Socket> accept(std::chrono::milliseconds aTimeout);
+
   //! Sends data to a remote host.
+  //! Note: for Stream (TCP) sockets, fewer bytes than requested may be sent (a
+  //! partial write) - this is not an error. Use sendAll() to send everything.
   //! On success, return value = number of bytes sent
   Result<std::size_t> send(const void* aData,
                            std::size_t aDataByteSize);
 
+  //! Same as send() but with per-call flags (combination of IoFlags::Enum values).
+  //! With IoFlags::DontWait, the call returns WouldBlock instead of blocking,
+  //! without switching the socket into non-blocking mode.
+  Result<std::size_t> send(const void* aData,
+                           std::size_t aDataByteSize,
+                           int aFlags);
+
+  //! Same as send() but gives up with a TimeoutError if nothing could be sent by
+  //! aDeadline. The socket's blocking mode is not changed.
+  Result<std::size_t> send(const void* aData,
+                           std::size_t aDataByteSize,
+                           Deadline aDeadline);
+
+  //! Same as above, with a deadline of aTimeout from now.
+  Result<std::size_t> send(const void* aData,
+                           std::size_t aDataByteSize,
+                           std::chrono::milliseconds aTimeout);
+
+  //! Sends all of the data, calling into libzt as many times as needed, until
+  //! everything is sent, an error occurs, or aDeadline passes (TimeoutError).
+  //! Works with both blocking and non-blocking sockets.
+  //! If aBytesSent is not null, it receives the number of bytes that were sent,
+  //! even if the call fails (so the transfer can be resumed).
+  //! On success, return value = aDataByteSize
+  Result<std::size_t> sendAll(const void* aData,
+                              std::size_t aDataByteSize,
+                              Deadline aDeadline = NO_DEADLINE,
+                              std::size_t* aBytesSent = nullptr);
+
+  //! Sends data gathered from multiple buffer segments (in order) to a remote host,
+  //! as if they were a single contiguous buffer, using a single call into libzt.
+  //! For example, a fixed-size header and a payload can be sent without having
+  //! to copy them into a temporary buffer first.
+  //! On success, return value = number of bytes sent
+  Result<std::size_t> sendv(const ConstBufferSegment* aSegments,
+                            std::size_t aSegmentCount);
+
   //! Sends data to a remote host.
   //! On success, return value = number of bytes sent
   Result<std::size_t> sendTo(const void* aData,
@@ -90,6 +253,23 @@ public:
                              const IpAddress& aRemoteIpAddress,
                              uint16_t aRemotePortInHostOrder);
 
+  //! Same as above but sends to an Endpoint, the address of which is already
+  //! encoded (use this when sending to the same peers repeatedly).
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const Endpoint& aRemoteEndpoint);
+
+  //! Sends multiple datagrams, in order, until all of them have been sent or until
+  //! sending one of them fails. The `bytesSent` field of each datagram that was
+  //! sent is filled out.
+  //! If the first datagram could not be sent, the error is reported; if some
+  //! datagrams were sent before the failure, only the count is reported (the
+  //! error will be reported by the next call).
+  //! Meant for Datagram (UDP) sockets.
+  //! On success, return value = number of datagrams sent
+  Result<std::size_t> sendToMany(OutgoingDatagram* aDatagrams,
+                                 std::size_t aDatagramCount);
+
   //! Receive data from the a remote host.
   //! If the destination buffer is not large enough to hold the whole message that was
   //! received, it will be truncanted to fit and no error will be reported. Thus, unless
@@ -97,17 +277,108 @@ public:
   //! would be to provide as large a buffer as you can. Note that the theoretical limit
   //! for both TCP and UDP packet size is 64kB, so anything more that that is a certain 
   //! waste of memory.
-  //! On successs, return value = number of bytes received (written to the buffer)
+  //! On successs, return value = number of bytes received (written to the buffer);
+  //! for Stream (TCP) sockets, 0 means that the remote closed the connection, and
+  //! for Datagram (UDP) sockets, that an empty datagram was received.
   Result<std::size_t> receive(void* aDestinationBuffer,
                               std::size_t aDestinationBufferByteSize);
 
+  //! Same as receive() but with per-call flags (combination of IoFlags::Enum values).
+  //! With IoFlags::Peek, the data stays queued and will be returned again by the
+  //! next call, which can be used to size a buffer before the real read.
+  //! If aTruncated is not null, it is set to whether the message was truncated to
+  //! fit into the buffer (only datagrams can be truncated).
+  //! Returns 0 on end of stream or for an empty datagram, same as receive().
+  Result<std::size_t> receive(void* aDestinationBuffer,
+                              std::size_t aDestinationBufferByteSize,
+                              int aFlags,
+                              bool* aTruncated = nullptr);
+
+  //! Same as receive() but gives up with a TimeoutError if nothing is received by
+  //! aDeadline. The socket's blocking mode is not changed.
+  //! Returns 0 on end of stream or for an empty datagram, same as receive().
+  Result<std::size_t> receive(void* aDestinationBuffer,
+                              std::size_t aDestinationBufferByteSize,
+                              Deadline aDeadline);
+
+  //! Same as above, with a deadline of aTimeout from now.
+  Result<std::size_t> receive(void* aDestinationBuffer,
+                              std::size_t aDestinationBufferByteSize,
+                              std::chrono::milliseconds aTimeout);
+
+  //! Same as receive() but receives directly into a buffer acquired from aBufferPool.
+  //! The returned Buffer's size is set to the number of bytes received, and it can
+  //! be handed off to other threads or consumers without copying the data.
+  //! Messages larger than the pool's slab size are truncated.
+  //! On failure, the buffer is returned to the pool. On end of stream or for an
+  //! empty datagram, the returned Buffer is empty (same as receive() returning 0).
+  Result<Buffer> receive(BufferPool& aBufferPool);
+
+  //! Receives exactly aByteCount bytes, calling into libzt as many times as needed,
+  //! unless an error occurs, the remote closes the connection (SocketError), or
+  //! aDeadline passes (TimeoutError). Meant for Stream (TCP) sockets.
+  //! If aBytesReceived is not null, it receives the number of bytes that were
+  //! received, even if the call fails.
+  //! On success, return value = aByteCount
+  Result<std::size_t> receiveExact(void* aDestinationBuffer,
+                                   std::size_t aByteCount,
+                                   Deadline aDeadline = NO_DEADLINE,
+                                   std::size_t* aBytesReceived = nullptr);
+
+  //! Receive data from a remote host and scatter it (in order) across multiple
+  //! buffer segments, using a single call into libzt. Each segment is filled
+  //! completely before moving on to the next one.
+  //! On successs, return value = total number of bytes received (written to the
+  //! segments); 0 means that the remote closed the connection (same as receive()).
+  Result<std::size_t> receivev(const BufferSegment* aSegments,
+                               std::size_t aSegmentCount);
+
   //! Same as receive() but also, on success, reports the sender's IP and port through 
-  //! the last two arguments.
+  //! the last two arguments. Returns 0 for an empty datagram (or, for Stream
+  //! sockets, on end of stream), same as receive().
   Result<std::size_t> receiveFrom(void* aDestinationBuffer,
                                   std::size_t aDestinationBufferByteSize,
                                   IpAddress& aSenderAddress,
                                   uint16_t& aSenderPort);
 
+  //! Same as receiveFrom() but reports the sender as an Endpoint, which can be
+  //! passed straight back to sendTo() without encoding it again. Optionally takes
+  //! per-call flags and reports truncation (see receive() above).
+  //! Returns 0 for an empty datagram, same as receiveFrom() above.
+  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
+                                  std::size_t aDestinationBufferByteSize,
+                                  Endpoint& aSenderEndpoint,
+                                  int aFlags = IoFlags::None,
+                                  bool* aTruncated = nullptr);
+
+  //! Same as receiveFrom() but with per-call flags and truncation reporting (see
+  //! receive() above). Returns 0 for an empty datagram, same as receiveFrom() above.
+  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
+                                  std::size_t aDestinationBufferByteSize,
+                                  IpAddress& aSenderAddress,
+                                  uint16_t& aSenderPort,
+                                  int aFlags,
+                                  bool* aTruncated = nullptr);
+
+  //! Same as receive(BufferPool&) but also, on success, reports the sender's IP and
+  //! port through the last two arguments. For an empty datagram, the returned
+  //! Buffer is empty.
+  Result<Buffer> receiveFrom(BufferPool& aBufferPool,
+                             IpAddress& aSenderAddress,
+                             uint16_t& aSenderPort);
+
+  //! Receives up to aDatagramCount datagrams in one call. Blocks (unless the socket
+  //! is non-blocking) until at least one datagram is available, and then drains
+  //! any further datagrams that are already queued without blocking again.
+  //! The output fields of the first N elements of aDatagrams are filled out (N
+  //! being the return value). As with receive(), datagrams that don't fit into
+  //! their buffers are truncated, and an empty datagram is reported with
+  //! bytesReceived = 0.
+  //! Meant for Datagram (UDP) sockets.
+  //! On success, return value = number of datagrams received
+  Result<std::size_t> receiveFromMany(IncomingDatagram* aDatagrams,
+                                      std::size_t aDatagramCount);
+
   //! On success, compare with PollEventBitmask::Enum to see which events have occurred.
   //! Blocks until any event marked in aInterestedIn occurs, or until aMaxTimeToWait has
   //! passed. If aMaxTimeToWait is 0, return immediately. If it is negative, waits 
@@ -116,6 +387,22 @@ public:
       PollEventBitmask::Enum aInterestedIn = PollEventBitmask::AnyEvent,
       std::chrono::milliseconds aMaxTimeToWait = std::chrono::milliseconds{0}) const;
 
+  //! Return the local address and port of the socket. The endpoint is recorded
+  //! by bind() (or looked up on the first call and then remembered), so repeated
+  //! calls don't call into libzt. Only fully specified endpoints are remembered:
+  //! while the socket isn't bound, every call looks the endpoint up again.
+  //! Forgotten by init() and close(); connect() forgets the local endpoint, as
+  //! connecting may implicitly bind the socket.
+  //! Note: because this (and getRemoteEndpoint()) may update the cached endpoint,
+  //! a Socket must not be used from multiple threads at once, not even through
+  //! const methods only.
+  Result<Endpoint> getLocalEndpoint() const;
+
+  //! Return the remote address and port of a connected socket. The endpoint is
+  //! recorded by connect() and accept() (or looked up on the first call and then
+  //! remembered), so repeated calls don't call into libzt.
+  Result<Endpoint> getRemoteEndpoint() const;
+
   //! Return the address to which the socket was bound.
   //! Will return an all-zero address for an unbound socket.
   Result<IpAddress> getLocalIpAddress() const;
@@ -132,6 +419,18 @@ public:
   //! Otherwise, returns an error.
   Result<uint16_t> getRemotePort() const;
 
+  //! Put the socket into non-blocking (true) or blocking (false) mode. Sockets are
+  //! blocking by default.
+  //! While a socket is non-blocking, send/receive/accept/connect methods return
+  //! immediately: if the operation can't be completed right away, they return a
+  //! Result for which wouldBlock() is true (and which doesn't allocate any memory).
+  //! A non-blocking connect() which returns WouldBlock continues in the background;
+  //! poll for PollEventBitmask::ReadyToSend to find out when it completes.
+  EmptyResult setNonBlocking(bool aNonBlocking);
+
+  //! Returns true if the socket is in non-blocking mode.
+  Result<bool> getNonBlocking() const;
+
   //! Return true if the socket was initialized successfully and is ready to send
   //! and receive traffic. Once close() is called, isOpen() will return false again.
   bool isOpen() const;
@@ -140,12 +439,112 @@ public:
   //! The socket can become functional again if you call init().
   EmptyResult close();
 
-  // Control commands
-  // TODO - RDONLY, WRONLY, send/recv flags...
+  // Socket options
+  // Note: option support depends on how libzt's network stack (lwIP) was
+  // configured; setting an unsupported option results in an error.
+
+  //! Enable or disable TCP_NODELAY (disables Nagle's algorithm when true, so small
+  //! writes are sent right away instead of being coalesced). Stream sockets only.
+  EmptyResult setNoDelay(bool aNoDelay);
+  Result<bool> getNoDelay() const;
+
+  //! Set or get the size of the socket's send buffer (SO_SNDBUF), in bytes.
+  EmptyResult setSendBufferSize(std::size_t aByteSize);
+  Result<std::size_t> getSendBufferSize() const;
+
+  //! Set or get the size of the socket's receive buffer (SO_RCVBUF), in bytes.
+  EmptyResult setReceiveBufferSize(std::size_t aByteSize);
+  Result<std::size_t> getReceiveBufferSize() const;
+
+  //! Enable or disable sending of TCP keep-alive probes (SO_KEEPALIVE).
+  EmptyResult setKeepAlive(bool aKeepAlive);
+  Result<bool> getKeepAlive() const;
+
+  //! Configure TCP keep-alive probes: how long the connection has to be idle
+  //! before the first probe is sent (TCP_KEEPIDLE), the interval between probes
+  //! (TCP_KEEPINTVL) and how many unanswered probes it takes to drop the
+  //! connection (TCP_KEEPCNT). Only has effect if keep-alive is enabled.
+  EmptyResult setKeepAliveParameters(std::chrono::seconds aIdleTime,
+                                     std::chrono::seconds aProbeInterval,
+                                     int aProbeCount);
+
+  //! Controls what close() does when unsent data remains (SO_LINGER).
+  struct LingerOption {
+    bool enabled;                  //! If false, close() returns immediately
+    std::chrono::seconds timeout;  //! How long close() may block while data is being sent
+  };
+
+  EmptyResult setLinger(const LingerOption& aLinger);
+  Result<LingerOption> getLinger() const;
+
+  //! Allow or disallow binding to an address which is still in use (SO_REUSEADDR).
+  //! Must be set before bind().
+  EmptyResult setReuseAddress(bool aReuseAddress);
+  Result<bool> getReuseAddress() const;
+
+  //! Set or get the Type-Of-Service / DSCP field of outgoing IPv4 packets (IP_TOS).
+  EmptyResult setTypeOfService(uint8_t aTypeOfService);
+  Result<uint8_t> getTypeOfService() const;
+
+  //! Set or get whether the socket may send datagrams to a broadcast address
+  //! (SO_BROADCAST). Only has an effect if broadcast is enabled on the ZeroTier
+  //! network (see Network::isBroadcastEnabled()).
+  EmptyResult setBroadcast(bool aBroadcast);
+  Result<bool> getBroadcast() const;
+
+  //! Join or leave an IP multicast group, so that datagrams sent to the group's
+  //! address are (or stop being) received by this socket. The group address must
+  //! be of the same family as the socket. For IPv4 sockets, aLocalInterfaceAddress
+  //! selects the interface (ZeroTier network) by its address; if it's invalid (the
+  //! default), the stack chooses. It's ignored for IPv6 sockets.
+  //! Meant for Datagram (UDP) sockets.
+  EmptyResult joinMulticastGroup(const IpAddress& aGroupAddress,
+                                 const IpAddress& aLocalInterfaceAddress = IpAddress{});
+  EmptyResult leaveMulticastGroup(const IpAddress& aGroupAddress,
+                                  const IpAddress& aLocalInterfaceAddress = IpAddress{});
+
+  //! Set or get the TTL (IPv4) or hop limit (IPv6) of outgoing multicast datagrams.
+  EmptyResult setMulticastTTL(uint8_t aTTL);
+  Result<uint8_t> getMulticastTTL() const;
+
+  //! Set or get whether multicast datagrams sent by this socket are also
+  //! delivered back to the local host.
+  EmptyResult setMulticastLoopback(bool aLoopback);
+  Result<bool> getMulticastLoopback() const;
+
+  //! Return a snapshot of the socket's activity counters. The counters are kept
+  //! with relaxed atomics, so this can be called from any thread while the socket
+  //! is in use (the snapshot isn't guaranteed to be consistent across fields).
+  //! The counters start from zero when the socket is initialized or accepted.
+  SocketStatistics getStatistics() const;
+
+  //! Reset all of the socket's activity counters to zero.
+  void resetStatistics();
 
 private:
   class Impl;
-  std::unique_ptr<Impl> _impl;
+
+  //! The Impl object is constructed in place in this storage instead of on the
+  //! heap, so creating, moving and accepting sockets never allocates (Socket.cpp
+  //! static_asserts that Impl fits).
+  static constexpr std::size_t IMPL_STORAGE_SIZE = 256;
+  static constexpr std::size_t IMPL_STORAGE_ALIGNMENT = 8;
+  alignas(IMPL_STORAGE_ALIGNMENT) unsigned char _implStorage[IMPL_STORAGE_SIZE];
+
+  Impl& getImpl();
+  const Impl& getImpl() const;
+
+  //! Used by accept() to wrap a newly accepted connection.
+  explicit Socket(Impl&& aImpl);
+
+  friend int detail::GetSocketID(const Socket&);
+};
+
+//! Describes a connection accepted by Socket::acceptMany().
+struct AcceptedConnection {
+  Socket    socket;              //! Socket which handles the connection
+  IpAddress remoteIpAddress;     //! Peer's address
+  uint16_t  remotePort;          //! Peer's port (in host order)
 };
 
 ZTCPP_NAMESPACE_END
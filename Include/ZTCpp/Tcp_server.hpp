@@ -0,0 +1,111 @@
+#ifndef ZTCPP_TCP_SERVER_HPP
+#define ZTCPP_TCP_SERVER_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Ip_address.hpp>
+#include <ZTCpp/Reactor.hpp>
+#include <ZTCpp/Result.hpp>
+#include <ZTCpp/Socket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Multi-threaded TCP server: a dedicated acceptor thread accepts incoming
+//! connections and hands them off to a pool of worker threads, each of which runs
+//! its own Reactor. A new connection always goes to the least loaded worker,
+//! where load is the number of sockets registered with the worker's reactor.
+class ZTCPP_API TcpServer {
+public:
+  //! Invoked on the acceptor thread when polling the listening socket or
+  //! accepting a connection fails (see Config::acceptErrorHandler).
+  using AcceptErrorHandler = std::function<void(const ErrorReport& aError)>;
+
+  struct Config {
+    //! Address and port to listen on
+    IpAddress localIpAddress = IpAddress::ipv4Unspecified();
+    uint16_t localPort = 0;
+
+    //! See Socket::listen()
+    std::size_t backlogSize = 128;
+
+    //! Number of worker threads (0 = one per hardware thread)
+    std::size_t workerCount = 0;
+
+    //! If true, worker N is pinned to CPU core N (modulo the number of cores the
+    //! process is allowed to run on, skipping the ones it isn't).
+    //! Supported on Windows and Linux; ignored elsewhere.
+    bool pinWorkersToCores = false;
+
+    //! Upper bound for how long a new connection can wait before its worker picks
+    //! it up (see Reactor::Reactor()), and the interval at which the acceptor
+    //! thread checks whether it should stop (at least 1ms). stop() therefore takes
+    //! about this long, plus however long the handlers that are running at the
+    //! time take to return.
+    std::chrono::milliseconds maxIdleWaitTime{5};
+
+    //! Optional. Transient errors are reported and retried with an increasing
+    //! delay (up to a second). If the listening socket itself fails (reports an
+    //! error or hang-up), that is reported as well and the server stops accepting
+    //! new connections (see isAccepting()); existing connections keep being served.
+    AcceptErrorHandler acceptErrorHandler;
+  };
+
+  //! Invoked on a worker thread for each accepted connection. The handler takes
+  //! ownership of the socket, and would normally register it (and keep it alive)
+  //! with aWorkerReactor, which it may only use from within its own handlers.
+  //! Sockets registered with aWorkerReactor count towards that worker's load.
+  using ConnectionHandler = std::function<void(Socket aSocket,
+                                               const IpAddress& aRemoteIpAddress,
+                                               uint16_t aRemotePort,
+                                               Reactor& aWorkerReactor)>;
+
+  //! Creates a server which isn't running.
+  TcpServer();
+
+  //! Copying and moving is unsupported
+  TcpServer(const TcpServer&) = delete;
+  TcpServer& operator=(const TcpServer&) = delete;
+
+  //! Stops the server if it's running.
+  ~TcpServer();
+
+  //! Create the listening socket and start the acceptor and worker threads.
+  //! Fails if the server is already running, or if the listening socket could
+  //! not be set up.
+  EmptyResult start(const Config& aConfig, ConnectionHandler aHandler);
+
+  //! Stop accepting connections, stop all threads and close the listening socket.
+  //! Blocks until all threads have finished. Worker reactors (and all the
+  //! sockets still registered with them) are destroyed after this.
+  void stop();
+
+  //! Returns true if the server is running.
+  bool isRunning() const;
+
+  //! Returns true if the server is running and still accepting connections
+  //! (false after the listening socket has failed).
+  bool isAccepting() const;
+
+  //! Returns the port the server is listening on (useful when Config::localPort
+  //! is 0). Returns 0 if the server is not running.
+  uint16_t getLocalPort() const;
+
+  //! Returns the number of worker threads (0 if the server is not running).
+  std::size_t getWorkerCount() const;
+
+  //! Returns the current load of a worker (see above).
+  std::size_t getWorkerLoad(std::size_t aWorkerIndex) const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_TCP_SERVER_HPP
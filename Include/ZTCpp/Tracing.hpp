@@ -0,0 +1,103 @@
+#ifndef ZTCPP_TRACING_HPP
+#define ZTCPP_TRACING_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+ZTCPP_NAMESPACE_BEGIN
+
+//! Describes a single call into libzt.
+struct TraceEvent {
+  const char* functionName;       //! Name of the libzt function (for example "zts_send")
+  int socketID;                   //! -1 if the call isn't made on a specific socket
+  std::size_t requestedByteCount; //! Bytes passed to a send/receive call (0 for other calls)
+  // The following are only valid in onCallEnd():
+  std::chrono::steady_clock::time_point beginTime;
+  std::chrono::steady_clock::time_point endTime;
+  int64_t result;                 //! Return value of the call (for send/receive calls,
+                                  //! the number of bytes transferred)
+};
+
+//! Receives a callback before and after every call ZTCpp makes into libzt
+//! (from any thread, on the thread making the call). The callbacks are on the
+//! hot path of every socket operation, so they should be quick and must not
+//! call back into ZTCpp or libzt.
+class ZTCPP_API TraceHookInterface {
+public:
+  virtual ~TraceHookInterface() = default;
+
+  //! Called just before the call is made. Does nothing by default.
+  virtual void onCallBegin(const TraceEvent& aEvent);
+
+  //! Called just after the call returns.
+  virtual void onCallEnd(const TraceEvent& aEvent) = 0;
+};
+
+//! Tracing is compiled out by default (every libzt call is made directly, with
+//! no overhead); configure with -DZTCPP_ENABLE_TRACING=ON to compile it in.
+//! Even then, nothing is traced until a hook is installed.
+class ZTCPP_API Tracing {
+public:
+  //! Return true if the library was built with ZTCPP_ENABLE_TRACING.
+  static bool isCompiledIn();
+
+  //! Install the hook to receive all subsequent calls (nullptr to stop tracing).
+  //! The hook is not owned: it must outlive every call that might still be
+  //! using it, so don't destroy it while other threads are calling into ZTCpp.
+  //! Has no effect if tracing isn't compiled in.
+  static void setTraceHook(TraceHookInterface* aHook);
+
+  static TraceHookInterface* getTraceHook();
+
+  Tracing() = delete;
+};
+
+//! Built-in trace hook which records every call as a complete ("X") event of
+//! the Chrome trace event format, which can be opened in Perfetto
+//! (ui.perfetto.dev) or chrome://tracing. Timestamps are relative to the time
+//! the recorder was created. Each event carries the socket ID, requested byte
+//! count and result of the call as arguments.
+//! All functions are thread-safe.
+class ZTCPP_API ChromeTraceRecorder : public TraceHookInterface {
+public:
+  //! Once aMaxEventCount events have been recorded, further events are dropped
+  //! (and counted; the count is written out as trace metadata).
+  explicit ChromeTraceRecorder(std::size_t aMaxEventCount = 1'000'000);
+
+  //! Copying and moving are unsupported (the recorder may be installed as the hook)
+  ChromeTraceRecorder(const ChromeTraceRecorder&) = delete;
+  ChromeTraceRecorder& operator=(const ChromeTraceRecorder&) = delete;
+
+  //! Regular destructor.
+  ~ChromeTraceRecorder() override;
+
+  void onCallEnd(const TraceEvent& aEvent) override;
+
+  //! Return the events recorded so far as a trace JSON document.
+  std::string toString() const;
+
+  //! Write the events recorded so far into the file at aPath as a trace JSON
+  //! document (replaced atomically, same as Metrics::writeToFile()).
+  EmptyResult writeToFile(const std::string& aPath) const;
+
+  std::size_t getEventCount() const;
+
+  std::size_t getDroppedEventCount() const;
+
+  //! Forget all recorded (and dropped) events.
+  void clear();
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_TRACING_HPP
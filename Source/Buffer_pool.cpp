@@ -0,0 +1,262 @@
+#include <ZTCpp/Buffer_pool.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+//! Header placed at the start of each slab allocation; the data follows it.
+struct BufferSlab {
+  std::atomic<std::uint32_t> referenceCount;
+  std::size_t size;
+  BufferPoolState* pool;
+
+  unsigned char* getData() {
+    return reinterpret_cast<unsigned char*>(this) + DATA_OFFSET;
+  }
+
+  static constexpr std::size_t DATA_OFFSET =
+    (sizeof(BufferSlab*) * 4 + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+    alignof(std::max_align_t);
+};
+
+static_assert(sizeof(BufferSlab) <= BufferSlab::DATA_OFFSET, "BufferSlab::DATA_OFFSET is too small");
+
+//! Shared between a BufferPool and its outstanding slabs: it stays alive for as
+//! long as either the pool or any of the slabs handed out by it is alive.
+class BufferPoolState {
+public:
+  BufferPoolState(std::size_t aSlabByteSize, std::size_t aMaxSlabCount)
+    : _slabByteSize{aSlabByteSize}
+    , _maxSlabCount{aMaxSlabCount}
+  {
+  }
+
+  void preallocate(std::size_t aSlabCount) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    while (_totalSlabCount < aSlabCount &&
+           (_maxSlabCount == 0 || _totalSlabCount < _maxSlabCount)) {
+      _freeSlabs.push_back(allocateSlab());
+    }
+  }
+
+  //! Returns nullptr if the pool is exhausted.
+  BufferSlab* acquire() {
+    BufferSlab* slab = nullptr;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      if (!_freeSlabs.empty()) {
+        slab = _freeSlabs.back();
+        _freeSlabs.pop_back();
+      }
+      else if (_maxSlabCount == 0 || _totalSlabCount < _maxSlabCount) {
+        slab = allocateSlab();
+      }
+      else {
+        return nullptr;
+      }
+    }
+    slab->referenceCount.store(1, std::memory_order_relaxed);
+    slab->size = 0;
+    _referenceCount.fetch_add(1, std::memory_order_relaxed);
+    return slab;
+  }
+
+  //! Called once the last Buffer referring to aSlab is gone.
+  void release(BufferSlab* aSlab) {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      if (_poolAlive) {
+        _freeSlabs.push_back(aSlab);
+      }
+      else {
+        freeSlab(aSlab);
+      }
+    }
+    dropReference();
+  }
+
+  //! Called by the BufferPool destructor.
+  void detachFromPool() {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _poolAlive = false;
+      for (auto* slab : _freeSlabs) {
+        freeSlab(slab);
+      }
+      _freeSlabs.clear();
+    }
+    dropReference();
+  }
+
+  std::size_t getSlabByteSize() const {
+    return _slabByteSize;
+  }
+
+  std::size_t getAvailableSlabCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _freeSlabs.size();
+  }
+
+  std::size_t getTotalSlabCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _totalSlabCount;
+  }
+
+private:
+  BufferSlab* allocateSlab() {
+    void* memory = ::operator new(BufferSlab::DATA_OFFSET + _slabByteSize);
+    auto* slab = new (memory) BufferSlab;
+    slab->referenceCount.store(0, std::memory_order_relaxed);
+    slab->size = 0;
+    slab->pool = this;
+    _totalSlabCount += 1;
+    return slab;
+  }
+
+  void freeSlab(BufferSlab* aSlab) {
+    aSlab->~BufferSlab();
+    ::operator delete(static_cast<void*>(aSlab));
+    _totalSlabCount -= 1;
+  }
+
+  void dropReference() {
+    if (_referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+  const std::size_t _slabByteSize;
+  const std::size_t _maxSlabCount;
+
+  mutable std::mutex _mutex;
+  std::vector<BufferSlab*> _freeSlabs;  // Protected by _mutex
+  std::size_t _totalSlabCount = 0;      // Protected by _mutex
+  bool _poolAlive = true;               // Protected by _mutex
+
+  std::atomic<std::size_t> _referenceCount{1}; // Pool + slabs in use
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////
+// BUFFER                                                                //
+///////////////////////////////////////////////////////////////////////////
+
+Buffer::Buffer()
+  : _slab{nullptr}
+{
+}
+
+Buffer::Buffer(detail::BufferSlab* aSlab)
+  : _slab{aSlab}
+{
+}
+
+Buffer::Buffer(const Buffer& aOther)
+  : _slab{aOther._slab}
+{
+  if (_slab) {
+    _slab->referenceCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Buffer& Buffer::operator=(const Buffer& aOther) {
+  if (this != &aOther) {
+    Buffer copy{aOther};
+    std::swap(_slab, copy._slab);
+  }
+  return *this;
+}
+
+Buffer::Buffer(Buffer&& aOther) noexcept
+  : _slab{aOther._slab}
+{
+  aOther._slab = nullptr;
+}
+
+Buffer& Buffer::operator=(Buffer&& aOther) noexcept {
+  std::swap(_slab, aOther._slab);
+  return *this;
+}
+
+Buffer::~Buffer() {
+  if (_slab && _slab->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    _slab->pool->release(_slab);
+  }
+}
+
+bool Buffer::isValid() const {
+  return _slab != nullptr;
+}
+
+void* Buffer::getData() {
+  return _slab ? _slab->getData() : nullptr;
+}
+
+const void* Buffer::getData() const {
+  return _slab ? _slab->getData() : nullptr;
+}
+
+std::size_t Buffer::getSize() const {
+  return _slab ? _slab->size : 0;
+}
+
+void Buffer::setSize(std::size_t aSize) {
+  assert(_slab && aSize <= getCapacity());
+  _slab->size = aSize;
+}
+
+std::size_t Buffer::getCapacity() const {
+  return _slab ? _slab->pool->getSlabByteSize() : 0;
+}
+
+std::size_t Buffer::getReferenceCount() const {
+  return _slab ? _slab->referenceCount.load(std::memory_order_relaxed) : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// BUFFER POOL                                                           //
+///////////////////////////////////////////////////////////////////////////
+
+BufferPool::BufferPool(std::size_t aSlabByteSize,
+                       std::size_t aInitialSlabCount,
+                       std::size_t aMaxSlabCount)
+  : _state{new detail::BufferPoolState{(aSlabByteSize > 0) ? aSlabByteSize : 1, aMaxSlabCount}}
+{
+  _state->preallocate(aInitialSlabCount);
+}
+
+BufferPool::~BufferPool() {
+  _state->detachFromPool();
+}
+
+Result<Buffer> BufferPool::acquire() {
+  auto* slab = _state->acquire();
+  if (slab == nullptr) {
+    return {ZTCPP_ERROR_REPORT(RuntimeError,
+                               "Buffer pool exhausted (all " +
+                               std::to_string(_state->getTotalSlabCount()) +
+                               " slabs are in use)")};
+  }
+  return {Buffer{slab}};
+}
+
+std::size_t BufferPool::getSlabByteSize() const {
+  return _state->getSlabByteSize();
+}
+
+std::size_t BufferPool::getAvailableSlabCount() const {
+  return _state->getAvailableSlabCount();
+}
+
+std::size_t BufferPool::getTotalSlabCount() const {
+  return _state->getTotalSlabCount();
+}
+
+ZTCPP_NAMESPACE_END
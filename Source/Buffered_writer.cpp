@@ -0,0 +1,166 @@
+#include <ZTCpp/Buffered_writer.hpp>
+
+#include <cstring>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+using Clock = std::chrono::steady_clock;
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// BUFFERED WRITER IMPL                                                  //
+///////////////////////////////////////////////////////////////////////////
+
+class BufferedWriter::Impl {
+public:
+  Impl(Socket& aSocket, std::size_t aFlushThreshold, std::chrono::milliseconds aMaxFlushDelay)
+    : _socket{&aSocket}
+    , _flushThreshold{(aFlushThreshold > 0) ? aFlushThreshold : 1}
+    , _maxFlushDelay{aMaxFlushDelay}
+  {
+    _buffer.reserve(_flushThreshold);
+  }
+
+  EmptyResult write(const void* aData, std::size_t aDataByteSize) {
+    if (aData == nullptr || aDataByteSize == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aData is null or aDataByteSize == 0")};
+    }
+
+    if (aDataByteSize >= _flushThreshold) {
+      // Too big to be worth copying
+      auto res = flush(NO_DEADLINE);
+      if (!res) {
+        return res;
+      }
+      return sendAll(aData, aDataByteSize, NO_DEADLINE);
+    }
+
+    if (_buffer.empty()) {
+      _oldestWriteTime = Clock::now();
+    }
+    const auto oldSize = _buffer.size();
+    _buffer.resize(oldSize + aDataByteSize);
+    std::memcpy(_buffer.data() + oldSize, aData, aDataByteSize);
+
+    if (_buffer.size() >= _flushThreshold) {
+      // The data is accepted at this point (whatever isn't sent stays buffered),
+      // so a failed flush is left for the next flush() or flushIfDue() to report
+      (void)flush(NO_DEADLINE);
+    }
+    return EmptyResultOK();
+  }
+
+  EmptyResult flush(Deadline aDeadline) {
+    if (_buffer.empty()) {
+      return EmptyResultOK();
+    }
+    std::size_t bytesSent = 0;
+    auto res = _socket->sendAll(_buffer.data(), _buffer.size(), aDeadline, &bytesSent);
+    // Keep whatever wasn't sent, so a flush that timed out can be retried
+    _buffer.erase(_buffer.begin(), _buffer.begin() + static_cast<std::ptrdiff_t>(bytesSent));
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return EmptyResultOK();
+  }
+
+  EmptyResult flushIfDue() {
+    const auto timeUntilDue = getTimeUntilFlushDue();
+    if (timeUntilDue.count() != 0) {
+      return EmptyResultOK();
+    }
+    return flush(NO_DEADLINE);
+  }
+
+  std::chrono::milliseconds getTimeUntilFlushDue() const {
+    if (_buffer.empty() || _corked) {
+      return std::chrono::milliseconds{-1};
+    }
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+      _oldestWriteTime + _maxFlushDelay - Clock::now());
+    return (remaining.count() > 0) ? remaining : std::chrono::milliseconds{0};
+  }
+
+  EmptyResult setCorked(bool aCorked) {
+    const bool wasCorked = _corked;
+    _corked = aCorked;
+    if (wasCorked && !aCorked) {
+      return flush(NO_DEADLINE);
+    }
+    return EmptyResultOK();
+  }
+
+  bool isCorked() const {
+    return _corked;
+  }
+
+  std::size_t getBufferedByteSize() const {
+    return _buffer.size();
+  }
+
+private:
+  EmptyResult sendAll(const void* aData, std::size_t aDataByteSize, Deadline aDeadline) {
+    auto res = _socket->sendAll(aData, aDataByteSize, aDeadline);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return EmptyResultOK();
+  }
+
+  Socket* _socket;
+  std::size_t _flushThreshold;
+  std::chrono::milliseconds _maxFlushDelay;
+  std::vector<char> _buffer;
+  Clock::time_point _oldestWriteTime;
+  bool _corked = false;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// BUFFERED WRITER                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+BufferedWriter::BufferedWriter(Socket& aSocket,
+                               std::size_t aFlushThreshold,
+                               std::chrono::milliseconds aMaxFlushDelay)
+  : _impl{std::make_unique<Impl>(aSocket, aFlushThreshold, aMaxFlushDelay)}
+{
+}
+
+BufferedWriter::~BufferedWriter() = default;
+
+BufferedWriter::BufferedWriter(BufferedWriter&&) = default;
+
+BufferedWriter& BufferedWriter::operator=(BufferedWriter&&) = default;
+
+EmptyResult BufferedWriter::write(const void* aData, std::size_t aDataByteSize) {
+  return _impl->write(aData, aDataByteSize);
+}
+
+EmptyResult BufferedWriter::flush(Deadline aDeadline) {
+  return _impl->flush(aDeadline);
+}
+
+EmptyResult BufferedWriter::flushIfDue() {
+  return _impl->flushIfDue();
+}
+
+std::chrono::milliseconds BufferedWriter::getTimeUntilFlushDue() const {
+  return _impl->getTimeUntilFlushDue();
+}
+
+EmptyResult BufferedWriter::setCorked(bool aCorked) {
+  return _impl->setCorked(aCorked);
+}
+
+bool BufferedWriter::isCorked() const {
+  return _impl->isCorked();
+}
+
+std::size_t BufferedWriter::getBufferedByteSize() const {
+  return _impl->getBufferedByteSize();
+}
+
+ZTCPP_NAMESPACE_END
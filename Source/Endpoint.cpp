@@ -0,0 +1,174 @@
+#include <ZTCpp/Endpoint.hpp>
+
+#include "Sockaddr_util.hpp"
+
+#include <cstring>
+
+#include <ZeroTierSockets.h>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+//! Parses a port number (decimal, 0-65535) which spans [aBegin, aEnd).
+bool ParsePort(const char* aBegin, const char* aEnd, std::uint16_t& aPort) {
+  if (aBegin == aEnd || aEnd - aBegin > 5) {
+    return false;
+  }
+  std::uint32_t value = 0;
+  for (const char* c = aBegin; c != aEnd; c += 1) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    value = value * 10 + static_cast<std::uint32_t>(*c - '0');
+  }
+  if (value > 65535) {
+    return false;
+  }
+  aPort = static_cast<std::uint16_t>(value);
+  return true;
+}
+
+Endpoint ParseEndpoint(const char* aString, std::size_t aLength) {
+  if (aString == nullptr || aLength == 0) {
+    return {};
+  }
+
+  const char* const end = aString + aLength;
+  const char* addressBegin;
+  const char* addressEnd;
+  const char* portBegin;
+  const bool isIPv6 = (aString[0] == '[');
+
+  if (isIPv6) {
+    addressBegin = aString + 1;
+    addressEnd = static_cast<const char*>(std::memchr(addressBegin, ']', aLength - 1));
+    if (addressEnd == nullptr || addressEnd + 1 == end || addressEnd[1] != ':') {
+      return {};
+    }
+    portBegin = addressEnd + 2;
+  }
+  else {
+    addressBegin = aString;
+    addressEnd = static_cast<const char*>(std::memchr(aString, ':', aLength));
+    if (addressEnd == nullptr) {
+      return {};
+    }
+    portBegin = addressEnd + 1;
+  }
+
+  std::uint16_t port;
+  if (!ParsePort(portBegin, end, port)) {
+    return {};
+  }
+
+  const auto addressLength = static_cast<std::size_t>(addressEnd - addressBegin);
+  if (addressLength == 0 || addressLength >= ZTS_IP_MAX_STR_LEN) {
+    return {};
+  }
+  char address[ZTS_IP_MAX_STR_LEN];
+  std::memcpy(address, addressBegin, addressLength);
+  address[addressLength] = '\0';
+
+  return Endpoint{isIPv6 ? IpAddress::ipv6FromString(address) : IpAddress::ipv4FromString(address),
+                  port};
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// ENDPOINT                                                              //
+///////////////////////////////////////////////////////////////////////////
+
+Endpoint::Endpoint()
+  : _sockaddrLength{0}
+  , _port{0}
+{
+}
+
+Endpoint::Endpoint(const IpAddress& aIpAddress, std::uint16_t aPortInHostOrder)
+  : _ipAddress{aIpAddress}
+  , _sockaddrLength{0}
+  , _port{aPortInHostOrder}
+{
+  static_assert(sizeof(struct zts_sockaddr_in)  <= SOCKADDR_STORAGE_SIZE &&
+                sizeof(struct zts_sockaddr_in6) <= SOCKADDR_STORAGE_SIZE,
+                "Endpoint::SOCKADDR_STORAGE_SIZE is too small");
+
+  if (!aIpAddress.isValid()) {
+    return;
+  }
+  const auto sockaddr = detail::ToSockaddr(aIpAddress, aPortInHostOrder);
+  _sockaddrLength = detail::GetSockaddrLength(&sockaddr);
+  std::memcpy(_sockaddr, &sockaddr, _sockaddrLength);
+}
+
+Endpoint Endpoint::fromString(const char* aString) {
+  return ParseEndpoint(aString, (aString != nullptr) ? std::strlen(aString) : 0);
+}
+
+Endpoint Endpoint::fromString(const std::string& aString) {
+  return ParseEndpoint(aString.data(), aString.size());
+}
+
+bool Endpoint::isValid() const {
+  return (_sockaddrLength != 0);
+}
+
+const IpAddress& Endpoint::getIpAddress() const {
+  return _ipAddress;
+}
+
+std::uint16_t Endpoint::getPort() const {
+  return _port;
+}
+
+std::string Endpoint::toString() const {
+  if (!isValid()) {
+    return "<Invalid endpoint>";
+  }
+  if (_ipAddress.getAddressFamily() == AddressFamily::IPv6) {
+    return "[" + _ipAddress.toString() + "]:" + std::to_string(_port);
+  }
+  return _ipAddress.toString() + ":" + std::to_string(_port);
+}
+
+ZTCPP_API bool operator==(const Endpoint& aLeft, const Endpoint& aRight) {
+  if (!aLeft.isValid() || !aRight.isValid()) {
+    return (aLeft.isValid() == aRight.isValid());
+  }
+  return (aLeft._port == aRight._port) && (aLeft._ipAddress == aRight._ipAddress);
+}
+
+ZTCPP_API bool operator!=(const Endpoint& aLeft, const Endpoint& aRight) {
+  return !(aLeft == aRight);
+}
+
+ZTCPP_API std::ostream& operator<<(std::ostream& aStream, const Endpoint& aEndpoint) {
+  return (aStream << aEndpoint.toString());
+}
+
+///////////////////////////////////////////////////////////////////////////
+// ENDPOINT ACCESS                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+const struct zts_sockaddr* EndpointAccess::getSockaddr(const Endpoint& aEndpoint) {
+  return reinterpret_cast<const struct zts_sockaddr*>(aEndpoint._sockaddr);
+}
+
+std::uint32_t EndpointAccess::getSockaddrLength(const Endpoint& aEndpoint) {
+  return aEndpoint._sockaddrLength;
+}
+
+void EndpointAccess::setFromSockaddr(Endpoint& aEndpoint,
+                                     const struct zts_sockaddr_storage* aSockaddr) {
+  ToIpAddressAndPort(aSockaddr, aEndpoint._ipAddress, aEndpoint._port);
+  aEndpoint._sockaddrLength = aEndpoint._ipAddress.isValid() ? GetSockaddrLength(aSockaddr) : 0;
+  std::memcpy(aEndpoint._sockaddr, aSockaddr, aEndpoint._sockaddrLength);
+}
+
+} // namespace detail
+
+ZTCPP_NAMESPACE_END
@@ -1,6 +1,7 @@
 
 #include <ZTCpp/Events.hpp>
 
+#include "Metrics_util.hpp"
 #include "Sockaddr_util.hpp"
 
 #include <cassert>
@@ -344,6 +345,8 @@ void IntermediateEventHandler(void* aEventMessage) {
     return;
   }
 
+  RecordEventMetric(data->event_code);
+
   std::scoped_lock<std::recursive_mutex> lock{g_eventHandlerMutex};
   auto* eventHandler = GetEventHandler();
   if (!eventHandler) {
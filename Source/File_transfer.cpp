@@ -0,0 +1,440 @@
+#include <ZTCpp/File_transfer.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <cerrno>
+  #include <cstring>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+//! How much of the file is mapped at a time.
+constexpr uint64_t MAP_WINDOW_BYTE_SIZE = 64 * 1024 * 1024;
+
+//! Used when the socket's buffer size can't be determined.
+constexpr std::size_t DEFAULT_CHUNK_BYTE_SIZE = 64 * 1024;
+
+std::string GetLastSystemErrorString() {
+#if defined(_WIN32)
+  return "error code " + std::to_string(GetLastError());
+#else
+  return std::strerror(errno);
+#endif
+}
+
+uint64_t GetMappingGranularity() {
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return systemInfo.dwAllocationGranularity;
+#else
+  const long pageSize = sysconf(_SC_PAGESIZE);
+  return (pageSize > 0) ? static_cast<uint64_t>(pageSize) : 4096;
+#endif
+}
+
+std::size_t GetChunkByteSize(const Result<std::size_t>& aSocketBufferSize) {
+  if (!aSocketBufferSize || *aSocketBufferSize == 0) {
+    return DEFAULT_CHUNK_BYTE_SIZE;
+  }
+  return *aSocketBufferSize;
+}
+
+//! A file which is accessed through one mapped view (window) at a time.
+class MappedFile {
+public:
+  MappedFile() = default;
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    unmap();
+#if defined(_WIN32)
+    if (_file != INVALID_HANDLE_VALUE) {
+      CloseHandle(_file);
+    }
+#else
+    if (_fd >= 0) {
+      ::close(_fd);
+    }
+#endif
+  }
+
+  //! Opens the file for reading, or for reading and writing (creating it if it
+  //! doesn't exist).
+  EmptyResult open(const std::string& aPath, bool aWritable) {
+    _path = aPath;
+    _writable = aWritable;
+#if defined(_WIN32)
+    _file = CreateFileA(aPath.c_str(),
+                        GENERIC_READ | (aWritable ? GENERIC_WRITE : 0),
+                        FILE_SHARE_READ,
+                        nullptr,
+                        aWritable ? OPEN_ALWAYS : OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                        nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
+      return makeError("Could not open");
+    }
+#else
+    int flags = aWritable ? (O_RDWR | O_CREAT) : O_RDONLY;
+  #ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+  #endif
+    _fd = ::open(aPath.c_str(), flags, 0644);
+    if (_fd < 0) {
+      return makeError("Could not open");
+    }
+#endif
+    return EmptyResultOK();
+  }
+
+  Result<uint64_t> getSize() const {
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size)) {
+      return {makeError("Could not get the size of")};
+    }
+    return {static_cast<uint64_t>(size.QuadPart)};
+#else
+    struct stat status;
+    if (fstat(_fd, &status) != 0) {
+      return {makeError("Could not get the size of")};
+    }
+    return {static_cast<uint64_t>(status.st_size)};
+#endif
+  }
+
+  //! Grows or shrinks the file. There must be no mapped view.
+  EmptyResult resize(uint64_t aByteSize) {
+#if defined(_WIN32)
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(aByteSize);
+    if (!SetFilePointerEx(_file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(_file)) {
+      return makeError("Could not resize");
+    }
+#else
+    if (ftruncate(_fd, static_cast<off_t>(aByteSize)) != 0) {
+      return makeError("Could not resize");
+    }
+#endif
+    return EmptyResultOK();
+  }
+
+  //! Grows the file from aOldByteSize to aByteSize, reserving disk space for the
+  //! added range (resize() would leave it as a hole). A write through a mapped
+  //! view can't report running out of space - it raises SIGBUS (an exception on
+  //! Windows) - so the space has to be reserved before the range is mapped.
+  EmptyResult allocate(uint64_t aOldByteSize, uint64_t aByteSize) {
+#if defined(_WIN32)
+    (void)aOldByteSize;
+    FILE_ALLOCATION_INFO allocationInfo;
+    allocationInfo.AllocationSize.QuadPart = static_cast<LONGLONG>(aByteSize);
+    if (!SetFileInformationByHandle(_file, FileAllocationInfo,
+                                    &allocationInfo, sizeof(allocationInfo))) {
+      return makeError("Could not allocate space for");
+    }
+    return resize(aByteSize);
+#elif defined(__APPLE__)
+    // No posix_fallocate() on macOS
+    fstore_t store{};
+    store.fst_flags = F_ALLOCATEALL;
+    store.fst_posmode = F_PEOFPOSMODE;
+    store.fst_offset = 0;
+    store.fst_length = static_cast<off_t>(aByteSize - aOldByteSize);
+    if (fcntl(_fd, F_PREALLOCATE, &store) == -1) {
+      return makeError("Could not allocate space for");
+    }
+    return resize(aByteSize);
+#else
+    const int error = posix_fallocate(_fd,
+                                      static_cast<off_t>(aOldByteSize),
+                                      static_cast<off_t>(aByteSize - aOldByteSize));
+    if (error != 0) {
+      errno = error; // posix_fallocate() doesn't set errno itself
+      return makeError("Could not allocate space for");
+    }
+    return EmptyResultOK();
+#endif
+  }
+
+  //! Maps aByteSize bytes of the file starting at aOffset (replacing the previous
+  //! view) and returns a pointer to the byte at aOffset.
+  Result<unsigned char*> map(uint64_t aOffset, std::size_t aByteSize) {
+    unmap();
+
+    static const uint64_t granularity = GetMappingGranularity();
+    const uint64_t alignedOffset = aOffset - (aOffset % granularity);
+    const auto leadingByteSize = static_cast<std::size_t>(aOffset - alignedOffset);
+    const std::size_t viewByteSize = leadingByteSize + aByteSize;
+
+#if defined(_WIN32)
+    HANDLE mapping = CreateFileMappingA(_file, nullptr,
+                                       _writable ? PAGE_READWRITE : PAGE_READONLY,
+                                       0, 0, nullptr);
+    if (mapping == nullptr) {
+      return {makeError("Could not map")};
+    }
+    void* view = MapViewOfFile(mapping,
+                               _writable ? FILE_MAP_WRITE : FILE_MAP_READ,
+                               static_cast<DWORD>(alignedOffset >> 32),
+                               static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                               viewByteSize);
+    CloseHandle(mapping); // The view keeps the mapping alive
+    if (view == nullptr) {
+      return {makeError("Could not map")};
+    }
+#else
+    void* view = mmap(nullptr, viewByteSize,
+                      _writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                      MAP_SHARED, _fd, static_cast<off_t>(alignedOffset));
+    if (view == MAP_FAILED) {
+      return {makeError("Could not map")};
+    }
+  #ifdef MADV_SEQUENTIAL
+    (void)madvise(view, viewByteSize, MADV_SEQUENTIAL);
+  #endif
+#endif
+
+    _view = view;
+    _viewByteSize = viewByteSize;
+    return {static_cast<unsigned char*>(view) + leadingByteSize};
+  }
+
+  void unmap() {
+    if (_view == nullptr) {
+      return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(_view);
+#else
+    munmap(_view, _viewByteSize);
+#endif
+    _view = nullptr;
+    _viewByteSize = 0;
+  }
+
+private:
+  std::unique_ptr<ErrorReport> makeError(const char* aAction) const {
+    return ZTCPP_ERROR_REPORT(RuntimeError,
+                              std::string{aAction} + " file '" + _path + "' (" +
+                              GetLastSystemErrorString() + ")");
+  }
+
+  std::string _path;
+  bool _writable = false;
+#if defined(_WIN32)
+  HANDLE _file = INVALID_HANDLE_VALUE;
+#else
+  int _fd = -1;
+#endif
+  void* _view = nullptr;
+  std::size_t _viewByteSize = 0;
+};
+
+//! Receive into the buffer, waiting for data even if the socket is non-blocking.
+Result<std::size_t> ReceiveChunk(Socket& aSocket,
+                                 void* aDestinationBuffer,
+                                 std::size_t aDestinationBufferByteSize,
+                                 Deadline aDeadline) {
+  while (true) {
+    auto res = aSocket.receive(aDestinationBuffer, aDestinationBufferByteSize, aDeadline);
+    if (!res.wouldBlock()) {
+      return res;
+    }
+    // Only possible for a non-blocking socket without a deadline
+    auto pollRes = aSocket.pollEvents(PollEventBitmask::ReadyToReceive,
+                                      std::chrono::milliseconds{-1});
+    if (!pollRes) {
+      return {std::make_unique<ErrorReport>(std::move(pollRes.getError()))};
+    }
+  }
+}
+
+std::unique_ptr<ErrorReport> MakeCancelledError(uint64_t aBytesTransferred) {
+  return ZTCPP_ERROR_REPORT(RuntimeError,
+                            "Transfer cancelled by the progress callback after " +
+                            std::to_string(aBytesTransferred) + " bytes");
+}
+
+} // namespace
+
+Result<uint64_t> FileTransfer::sendFile(Socket& aSocket,
+                                        const std::string& aPath,
+                                        uint64_t aOffset,
+                                        uint64_t aLength,
+                                        const FileTransferProgressCallback& aProgressCallback,
+                                        Deadline aDeadline) {
+  MappedFile file;
+  {
+    auto res = file.open(aPath, false);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+  }
+
+  auto fileSize = file.getSize();
+  if (!fileSize) {
+    return fileSize;
+  }
+  if (aOffset > *fileSize) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aOffset is past the end of the file")};
+  }
+  const uint64_t length = (aLength == TO_END) ? (*fileSize - aOffset) : aLength;
+  if (length > *fileSize - aOffset) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aOffset + aLength is past the end of the file")};
+  }
+
+  const std::size_t chunkByteSize = GetChunkByteSize(aSocket.getSendBufferSize());
+
+  uint64_t bytesSent = 0;
+  while (bytesSent < length) {
+    const auto windowByteSize = static_cast<std::size_t>(
+      std::min(MAP_WINDOW_BYTE_SIZE, length - bytesSent));
+    auto window = file.map(aOffset + bytesSent, windowByteSize);
+    if (!window) {
+      return {std::make_unique<ErrorReport>(std::move(window.getError()))};
+    }
+
+    std::size_t windowBytesSent = 0;
+    while (windowBytesSent < windowByteSize) {
+      const std::size_t chunk = std::min(chunkByteSize, windowByteSize - windowBytesSent);
+      std::size_t chunkBytesSent = 0;
+      auto res = aSocket.sendAll(*window + windowBytesSent, chunk, aDeadline, &chunkBytesSent);
+      windowBytesSent += chunkBytesSent;
+      bytesSent += chunkBytesSent;
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      if (aProgressCallback &&
+          !aProgressCallback(FileTransferProgress{bytesSent, length, aOffset + bytesSent})) {
+        return {MakeCancelledError(bytesSent)};
+      }
+    }
+  }
+
+  return {bytesSent};
+}
+
+Result<uint64_t> FileTransfer::receiveToFile(Socket& aSocket,
+                                             const std::string& aPath,
+                                             uint64_t aOffset,
+                                             uint64_t aLength,
+                                             const FileTransferProgressCallback& aProgressCallback,
+                                             Deadline aDeadline) {
+  MappedFile file;
+  {
+    auto res = file.open(aPath, true);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+  }
+
+  auto originalFileSize = file.getSize();
+  if (!originalFileSize) {
+    return originalFileSize;
+  }
+  uint64_t fileSize = *originalFileSize;
+
+  const bool lengthIsKnown = (aLength != TO_END);
+  if (lengthIsKnown && aLength > TO_END - aOffset) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aOffset + aLength is too large")};
+  }
+
+  const std::size_t chunkByteSize = GetChunkByteSize(aSocket.getReceiveBufferSize());
+
+  uint64_t bytesReceived = 0;
+
+  // The file is grown, and its space reserved, ahead of the data (a mapped view
+  // can't extend past the end of the file), so any space that wasn't filled is
+  // given back at the end
+  const auto trimFile = [&]() -> EmptyResult {
+    file.unmap();
+    const uint64_t finalSize = std::max(*originalFileSize, aOffset + bytesReceived);
+    if (fileSize > finalSize) {
+      return file.resize(finalSize);
+    }
+    return EmptyResultOK();
+  };
+  const auto fail = [&](std::unique_ptr<ErrorReport> aErrorReport) -> Result<uint64_t> {
+    (void)trimFile();
+    return {std::move(aErrorReport)};
+  };
+
+  bool connectionClosed = false;
+  while (!connectionClosed && (!lengthIsKnown || bytesReceived < aLength)) {
+    const uint64_t windowOffset = aOffset + bytesReceived;
+    const auto windowByteSize = static_cast<std::size_t>(
+      lengthIsKnown ? std::min(MAP_WINDOW_BYTE_SIZE, aLength - bytesReceived)
+                    : MAP_WINDOW_BYTE_SIZE);
+
+    if (windowOffset + windowByteSize > fileSize) {
+      file.unmap();
+      const uint64_t newFileSize = lengthIsKnown ? (aOffset + aLength)
+                                                 : (windowOffset + windowByteSize);
+      const uint64_t oldFileSize = fileSize;
+      fileSize = newFileSize; // Even if allocating fails, the file may have grown
+      auto res = file.allocate(oldFileSize, newFileSize);
+      if (!res) {
+        return fail(std::make_unique<ErrorReport>(std::move(res.getError())));
+      }
+    }
+
+    auto window = file.map(windowOffset, windowByteSize);
+    if (!window) {
+      return fail(std::make_unique<ErrorReport>(std::move(window.getError())));
+    }
+
+    std::size_t windowBytesReceived = 0;
+    while (windowBytesReceived < windowByteSize) {
+      const std::size_t chunk = std::min(chunkByteSize, windowByteSize - windowBytesReceived);
+      auto res = ReceiveChunk(aSocket, *window + windowBytesReceived, chunk, aDeadline);
+      if (!res) {
+        return fail(std::make_unique<ErrorReport>(std::move(res.getError())));
+      }
+      if (*res == 0) {
+        connectionClosed = true;
+        break;
+      }
+      windowBytesReceived += *res;
+      bytesReceived += *res;
+      if (aProgressCallback &&
+          !aProgressCallback(FileTransferProgress{bytesReceived,
+                                                  lengthIsKnown ? aLength : 0,
+                                                  aOffset + bytesReceived})) {
+        return fail(MakeCancelledError(bytesReceived));
+      }
+    }
+  }
+
+  auto res = trimFile();
+  if (!res) {
+    return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+  }
+  if (lengthIsKnown && bytesReceived < aLength) {
+    return {ZTCPP_ERROR_REPORT(SocketError,
+                               "Connection closed by the remote after " +
+                               std::to_string(bytesReceived) + " of " +
+                               std::to_string(aLength) + " bytes")};
+  }
+  return {bytesReceived};
+}
+
+ZTCPP_NAMESPACE_END
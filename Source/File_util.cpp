@@ -0,0 +1,46 @@
+#include "File_util.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+EmptyResult WriteFileAtomically(const std::string& aPath, const std::string& aContents) {
+  static std::atomic<uint64_t> writeCounter{0};
+  const std::string temporaryPath =
+    aPath + ".tmp" +
+    std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "-" +
+    std::to_string(writeCounter.fetch_add(1, std::memory_order_relaxed));
+
+  std::error_code errorCode;
+  {
+    std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+    if (!file) {
+      return {ZTCPP_ERROR_REPORT(RuntimeError,
+                                 "Could not open file '" + temporaryPath + "' for writing")};
+    }
+    file.write(aContents.data(), static_cast<std::streamsize>(aContents.size()));
+    file.close();
+    if (!file) {
+      std::filesystem::remove(temporaryPath, errorCode);
+      return {ZTCPP_ERROR_REPORT(RuntimeError,
+                                 "Could not write file '" + temporaryPath + "'")};
+    }
+  }
+
+  std::filesystem::rename(temporaryPath, aPath, errorCode);
+  if (errorCode) {
+    std::filesystem::remove(temporaryPath, errorCode);
+    return {ZTCPP_ERROR_REPORT(RuntimeError,
+                               "Could not rename '" + temporaryPath + "' to '" + aPath + "'")};
+  }
+  return EmptyResultOK();
+}
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
@@ -0,0 +1,21 @@
+#ifndef ZTCPP_FILE_UTIL_HPP
+#define ZTCPP_FILE_UTIL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Result.hpp>
+
+#include <string>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+//! Replace the contents of the file at aPath with aContents atomically: the data
+//! is written under a temporary name (unique to this call, so that concurrent
+//! writers of the same file don't interfere) and then renamed, so a reader never
+//! sees a partially written file.
+EmptyResult WriteFileAtomically(const std::string& aPath, const std::string& aContents);
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_FILE_UTIL_HPP
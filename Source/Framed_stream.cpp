@@ -0,0 +1,227 @@
+#include <ZTCpp/Framed_stream.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+void EncodeHeader(std::size_t aMessageByteSize, unsigned char* aHeader) {
+  const auto size = static_cast<std::uint32_t>(aMessageByteSize);
+  aHeader[0] = static_cast<unsigned char>((size >> 24) & 0xFF);
+  aHeader[1] = static_cast<unsigned char>((size >> 16) & 0xFF);
+  aHeader[2] = static_cast<unsigned char>((size >>  8) & 0xFF);
+  aHeader[3] = static_cast<unsigned char>((size >>  0) & 0xFF);
+}
+
+std::size_t DecodeHeader(const unsigned char* aHeader) {
+  return (static_cast<std::size_t>(aHeader[0]) << 24) |
+         (static_cast<std::size_t>(aHeader[1]) << 16) |
+         (static_cast<std::size_t>(aHeader[2]) <<  8) |
+         (static_cast<std::size_t>(aHeader[3]) <<  0);
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// FRAMED STREAM IMPL                                                    //
+///////////////////////////////////////////////////////////////////////////
+
+class FramedStream::Impl {
+public:
+  Impl(Socket& aSocket, std::size_t aMaxMessageByteSize, std::size_t aReceiveChunkByteSize)
+    : _socket{&aSocket}
+    , _maxMessageByteSize{std::min<std::size_t>(aMaxMessageByteSize, 0xFFFFFFFFu)}
+    , _buffer(std::max(aReceiveChunkByteSize, HEADER_BYTE_SIZE))
+  {
+  }
+
+  EmptyResult sendMessage(const void* aData,
+                          std::size_t aDataByteSize,
+                          Deadline aDeadline) {
+    if (aData == nullptr && aDataByteSize != 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aData is null")};
+    }
+    if (aDataByteSize > _maxMessageByteSize) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "Message is larger than the maximum message size (" +
+                                 std::to_string(_maxMessageByteSize) + " bytes)")};
+    }
+
+    unsigned char header[HEADER_BYTE_SIZE];
+    EncodeHeader(aDataByteSize, header);
+
+    // Try to send both parts with a single call. sendv() can't be bounded by a
+    // deadline (on a blocking socket it could block for as long as the send
+    // buffer stays full), so with a deadline everything goes through sendAll()
+    std::size_t sent = 0;
+    if (aDeadline == NO_DEADLINE) {
+      const ConstBufferSegment segments[] = {
+        {header, HEADER_BYTE_SIZE},
+        {aData, aDataByteSize}
+      };
+      auto res = _socket->sendv(segments, (aDataByteSize > 0) ? 2 : 1);
+      if (res) {
+        sent = *res;
+      }
+      else if (!res.wouldBlock()) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+    }
+
+    // Send whatever wasn't sent in the first go
+    if (sent < HEADER_BYTE_SIZE) {
+      auto res = _socket->sendAll(header + sent, HEADER_BYTE_SIZE - sent, aDeadline);
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      sent = HEADER_BYTE_SIZE;
+    }
+    const std::size_t payloadSent = sent - HEADER_BYTE_SIZE;
+    if (payloadSent < aDataByteSize) {
+      auto res = _socket->sendAll(static_cast<const char*>(aData) + payloadSent,
+                                  aDataByteSize - payloadSent,
+                                  aDeadline);
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+    }
+
+    return EmptyResultOK();
+  }
+
+  Result<MessageView> receiveMessage() {
+    for (;;) {
+      // Serve a buffered message if there is one
+      std::size_t messageByteSize = 0;
+      if (getBufferedFrame(messageByteSize)) {
+        const MessageView view{_buffer.data() + _readPosition + HEADER_BYTE_SIZE, messageByteSize};
+        _readPosition += HEADER_BYTE_SIZE + messageByteSize;
+        return {view};
+      }
+      if (_unusable) {
+        return {ZTCPP_ERROR_REPORT(RuntimeError,
+                                   "Stream is unusable after a framing error")};
+      }
+      if (getUnreadByteCount() >= HEADER_BYTE_SIZE && messageByteSize > _maxMessageByteSize) {
+        _unusable = true;
+        return {ZTCPP_ERROR_REPORT(RuntimeError,
+                                   "Received message header declares " +
+                                   std::to_string(messageByteSize) + " bytes, which exceeds " +
+                                   "the maximum message size")};
+      }
+
+      // Make room for the rest of the frame
+      makeRoom(HEADER_BYTE_SIZE + messageByteSize);
+
+      // Receive as much as fits in one call
+      auto res = _socket->receive(_buffer.data() + _writePosition,
+                                  _buffer.size() - _writePosition);
+      if (!res) {
+        if (res.wouldBlock()) {
+          return ResultWouldBlock();
+        }
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      if (*res == 0) {
+        return {ZTCPP_ERROR_REPORT(SocketError,
+                                   "Connection closed by the remote")};
+      }
+      _writePosition += *res;
+    }
+  }
+
+  bool hasBufferedMessage() const {
+    std::size_t dummy;
+    return getBufferedFrame(dummy);
+  }
+
+  Socket& getSocket() const {
+    return *_socket;
+  }
+
+private:
+  std::size_t getUnreadByteCount() const {
+    return _writePosition - _readPosition;
+  }
+
+  //! Returns true if a complete frame starts at _readPosition. If at least a
+  //! complete header is buffered, aMessageByteSize receives the message size.
+  bool getBufferedFrame(std::size_t& aMessageByteSize) const {
+    if (getUnreadByteCount() < HEADER_BYTE_SIZE) {
+      aMessageByteSize = 0;
+      return false;
+    }
+    aMessageByteSize = DecodeHeader(_buffer.data() + _readPosition);
+    return aMessageByteSize <= _maxMessageByteSize &&
+           getUnreadByteCount() >= HEADER_BYTE_SIZE + aMessageByteSize;
+  }
+
+  //! Ensure that a frame of aFrameByteSize bytes can fit after _readPosition,
+  //! and that there's free space after _writePosition.
+  void makeRoom(std::size_t aFrameByteSize) {
+    // Move unread data to the front of the buffer
+    if (_readPosition > 0) {
+      const std::size_t unread = getUnreadByteCount();
+      if (unread > 0) {
+        std::memmove(_buffer.data(), _buffer.data() + _readPosition, unread);
+      }
+      _readPosition = 0;
+      _writePosition = unread;
+    }
+    if (_buffer.size() < aFrameByteSize) {
+      _buffer.resize(aFrameByteSize);
+    }
+    if (_writePosition == _buffer.size()) {
+      // Can only happen while waiting for the header with a tiny buffer
+      _buffer.resize(_buffer.size() + HEADER_BYTE_SIZE);
+    }
+  }
+
+  Socket* _socket;
+  std::size_t _maxMessageByteSize;
+  std::vector<unsigned char> _buffer;
+  std::size_t _readPosition = 0;  // Start of unread data in _buffer
+  std::size_t _writePosition = 0; // End of received data in _buffer
+  bool _unusable = false;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// FRAMED STREAM                                                         //
+///////////////////////////////////////////////////////////////////////////
+
+FramedStream::FramedStream(Socket& aSocket,
+                           std::size_t aMaxMessageByteSize,
+                           std::size_t aReceiveChunkByteSize)
+  : _impl{std::make_unique<Impl>(aSocket, aMaxMessageByteSize, aReceiveChunkByteSize)}
+{
+}
+
+FramedStream::~FramedStream() = default;
+
+FramedStream::FramedStream(FramedStream&&) = default;
+
+FramedStream& FramedStream::operator=(FramedStream&&) = default;
+
+EmptyResult FramedStream::sendMessage(const void* aData,
+                                      std::size_t aDataByteSize,
+                                      Deadline aDeadline) {
+  return _impl->sendMessage(aData, aDataByteSize, aDeadline);
+}
+
+Result<MessageView> FramedStream::receiveMessage() {
+  return _impl->receiveMessage();
+}
+
+bool FramedStream::hasBufferedMessage() const {
+  return _impl->hasBufferedMessage();
+}
+
+Socket& FramedStream::getSocket() const {
+  return _impl->getSocket();
+}
+
+ZTCPP_NAMESPACE_END
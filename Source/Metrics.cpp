@@ -0,0 +1,437 @@
+#include <ZTCpp/Metrics.hpp>
+#include <ZTCpp/Events.hpp>
+
+#include "File_util.hpp"
+#include "Metrics_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t ERROR_CODE_COUNT = ErrorCode::TimeoutError + 1;
+
+const char* const ERROR_CODE_NAMES[ERROR_CODE_COUNT] = {
+  "GenericError",
+  "RuntimeError",
+  "ArgumentError",
+  "SocketError",
+  "ServiceError",
+  "WouldBlock",
+  "TimeoutError"
+};
+
+//! One per EventCode category (plus events that don't belong to any).
+enum EventCategory {
+  EVENT_CATEGORY_ADDRESS,
+  EVENT_CATEGORY_NETWORK,
+  EVENT_CATEGORY_NETWORK_INTERFACE,
+  EVENT_CATEGORY_NETWORK_STACK,
+  EVENT_CATEGORY_NODE,
+  EVENT_CATEGORY_PEER,
+  EVENT_CATEGORY_ROUTE,
+  EVENT_CATEGORY_UNKNOWN,
+
+  EVENT_CATEGORY_COUNT
+};
+
+const char* const EVENT_CATEGORY_NAMES[EVENT_CATEGORY_COUNT] = {
+  "address",
+  "network",
+  "network_interface",
+  "network_stack",
+  "node",
+  "peer",
+  "route",
+  "unknown"
+};
+
+template <class taEnum>
+bool IsInRange(int aEventCode, taEnum aFirst, taEnum aLast) {
+  return aEventCode >= static_cast<int>(aFirst) && aEventCode <= static_cast<int>(aLast);
+}
+
+EventCategory GetEventCategory(int aEventCode) {
+  if (IsInRange(aEventCode, EventCode::Address::AddedIPv4, EventCode::Address::RemovedIPv6)) {
+    return EVENT_CATEGORY_ADDRESS;
+  }
+  if (IsInRange(aEventCode, EventCode::Network::NotFound, EventCode::Network::Update)) {
+    return EVENT_CATEGORY_NETWORK;
+  }
+  if (IsInRange(aEventCode, EventCode::NetworkInterface::Up, EventCode::NetworkInterface::LinkDown)) {
+    return EVENT_CATEGORY_NETWORK_INTERFACE;
+  }
+  if (IsInRange(aEventCode, EventCode::NetworkStack::Up, EventCode::NetworkStack::Down)) {
+    return EVENT_CATEGORY_NETWORK_STACK;
+  }
+  if (IsInRange(aEventCode, EventCode::Node::Up, EventCode::Node::NormalTermination)) {
+    return EVENT_CATEGORY_NODE;
+  }
+  if (IsInRange(aEventCode, EventCode::Peer::Direct, EventCode::Peer::PathDead)) {
+    return EVENT_CATEGORY_PEER;
+  }
+  if (IsInRange(aEventCode, EventCode::Route::Added, EventCode::Route::Removed)) {
+    return EVENT_CATEGORY_ROUTE;
+  }
+  return EVENT_CATEGORY_UNKNOWN;
+}
+
+//! Upper bounds of the LocalNode::start() duration histogram buckets (the last,
+//! +Inf bucket is implied).
+struct HistogramBound {
+  uint64_t microseconds;
+  const char* label;
+};
+
+constexpr HistogramBound NODE_START_BOUNDS[] = {
+  {   100000, "0.1"},
+  {   250000, "0.25"},
+  {   500000, "0.5"},
+  {  1000000, "1"},
+  {  2500000, "2.5"},
+  {  5000000, "5"},
+  { 10000000, "10"},
+  { 30000000, "30"},
+  { 60000000, "60"}
+};
+
+constexpr std::size_t NODE_START_BUCKET_COUNT = std::size(NODE_START_BOUNDS) + 1;
+
+using Counter = std::atomic<uint64_t>;
+
+//! Each counter has a single writer (the thread owning the shard, or whoever holds
+//! the registry mutex for the retired shard), so a relaxed load and store is
+//! enough - no read-modify-write needed.
+void Add(Counter& aCounter, uint64_t aValue) {
+  aCounter.store(aCounter.load(std::memory_order_relaxed) + aValue, std::memory_order_relaxed);
+}
+
+uint64_t Get(const Counter& aCounter) {
+  return aCounter.load(std::memory_order_relaxed);
+}
+
+//! One thread's share of the metrics (cache line aligned, so that threads
+//! never write to the same cache line).
+struct alignas(64) Shard {
+  Counter socketsOpened{0};
+  Counter socketsClosed{0};
+  Counter bytesSent{0};
+  Counter bytesReceived{0};
+  Counter errors[ERROR_CODE_COUNT] = {};
+  Counter events[EVENT_CATEGORY_COUNT] = {};
+  Counter nodeStartBuckets[NODE_START_BUCKET_COUNT] = {}; // Not cumulative
+  Counter nodeStartCount{0};
+  Counter nodeStartMicroseconds{0};
+};
+
+void AddShard(Shard& aDestination, const Shard& aSource) {
+  Add(aDestination.socketsOpened, Get(aSource.socketsOpened));
+  Add(aDestination.socketsClosed, Get(aSource.socketsClosed));
+  Add(aDestination.bytesSent,     Get(aSource.bytesSent));
+  Add(aDestination.bytesReceived, Get(aSource.bytesReceived));
+  for (std::size_t i = 0; i < ERROR_CODE_COUNT; i += 1) {
+    Add(aDestination.errors[i], Get(aSource.errors[i]));
+  }
+  for (std::size_t i = 0; i < EVENT_CATEGORY_COUNT; i += 1) {
+    Add(aDestination.events[i], Get(aSource.events[i]));
+  }
+  for (std::size_t i = 0; i < NODE_START_BUCKET_COUNT; i += 1) {
+    Add(aDestination.nodeStartBuckets[i], Get(aSource.nodeStartBuckets[i]));
+  }
+  Add(aDestination.nodeStartCount,        Get(aSource.nodeStartCount));
+  Add(aDestination.nodeStartMicroseconds, Get(aSource.nodeStartMicroseconds));
+}
+
+//! Keeps track of the shards of all live threads; the counts of threads which
+//! have exited are folded into a single retired shard.
+class Registry {
+public:
+  void add(Shard* aShard) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _shards.push_back(aShard);
+  }
+
+  void retire(Shard* aShard) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    AddShard(_retiredShard, *aShard);
+    _shards.erase(std::remove(_shards.begin(), _shards.end(), aShard), _shards.end());
+  }
+
+  void collect(Shard& aTotals) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    AddShard(aTotals, _retiredShard);
+    for (const auto* shard : _shards) {
+      AddShard(aTotals, *shard);
+    }
+  }
+
+private:
+  std::mutex _mutex;
+  std::vector<Shard*> _shards;
+  Shard _retiredShard;
+};
+
+Registry& GetRegistry() {
+  // Never destroyed, as threads can exit (and retire their shards) during or
+  // after static destruction
+  static Registry* registry = new Registry{};
+  return *registry;
+}
+
+class ThreadShard {
+public:
+  ThreadShard() {
+    GetRegistry().add(&_shard);
+  }
+
+  ~ThreadShard() {
+    GetRegistry().retire(&_shard);
+  }
+
+  Shard& get() {
+    return _shard;
+  }
+
+private:
+  Shard _shard;
+};
+
+Shard& GetThreadShard() {
+  thread_local ThreadShard threadShard;
+  return threadShard.get();
+}
+
+///// FORMATTING /////
+
+std::string FormatSeconds(uint64_t aMicroseconds) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(aMicroseconds) / 1e6);
+  return buffer;
+}
+
+void AppendPrometheusHeader(std::string& aOutput, const char* aName, const char* aType, const char* aHelp) {
+  aOutput += "# HELP ";
+  aOutput += aName;
+  aOutput += ' ';
+  aOutput += aHelp;
+  aOutput += "\n# TYPE ";
+  aOutput += aName;
+  aOutput += ' ';
+  aOutput += aType;
+  aOutput += '\n';
+}
+
+void AppendPrometheusSample(std::string& aOutput,
+                            const char* aName,
+                            const char* aLabel,
+                            const char* aLabelValue,
+                            const std::string& aValue) {
+  aOutput += aName;
+  if (aLabel != nullptr) {
+    aOutput += '{';
+    aOutput += aLabel;
+    aOutput += "=\"";
+    aOutput += aLabelValue;
+    aOutput += "\"}";
+  }
+  aOutput += ' ';
+  aOutput += aValue;
+  aOutput += '\n';
+}
+
+std::string FormatPrometheus(const Shard& aTotals, uint64_t aSocketsOpen) {
+  std::string output;
+  output.reserve(4096);
+
+  AppendPrometheusHeader(output, "ztcpp_sockets_open", "gauge",
+                         "Number of ZTCpp sockets currently open.");
+  AppendPrometheusSample(output, "ztcpp_sockets_open", nullptr, nullptr, std::to_string(aSocketsOpen));
+
+  AppendPrometheusHeader(output, "ztcpp_sockets_opened_total", "counter",
+                         "Number of ZTCpp sockets opened (initialized or accepted).");
+  AppendPrometheusSample(output, "ztcpp_sockets_opened_total", nullptr, nullptr,
+                         std::to_string(Get(aTotals.socketsOpened)));
+
+  AppendPrometheusHeader(output, "ztcpp_bytes_sent_total", "counter",
+                         "Bytes sent through ZTCpp sockets.");
+  AppendPrometheusSample(output, "ztcpp_bytes_sent_total", nullptr, nullptr,
+                         std::to_string(Get(aTotals.bytesSent)));
+
+  AppendPrometheusHeader(output, "ztcpp_bytes_received_total", "counter",
+                         "Bytes received through ZTCpp sockets.");
+  AppendPrometheusSample(output, "ztcpp_bytes_received_total", nullptr, nullptr,
+                         std::to_string(Get(aTotals.bytesReceived)));
+
+  AppendPrometheusHeader(output, "ztcpp_errors_total", "counter",
+                         "Errors reported by ZTCpp, by error code.");
+  for (std::size_t i = 0; i < ERROR_CODE_COUNT; i += 1) {
+    AppendPrometheusSample(output, "ztcpp_errors_total", "code", ERROR_CODE_NAMES[i],
+                           std::to_string(Get(aTotals.errors[i])));
+  }
+
+  AppendPrometheusHeader(output, "ztcpp_events_total", "counter",
+                         "ZeroTier events received, by event category.");
+  for (std::size_t i = 0; i < EVENT_CATEGORY_COUNT; i += 1) {
+    AppendPrometheusSample(output, "ztcpp_events_total", "category", EVENT_CATEGORY_NAMES[i],
+                           std::to_string(Get(aTotals.events[i])));
+  }
+
+  AppendPrometheusHeader(output, "ztcpp_node_start_duration_seconds", "histogram",
+                         "Duration of LocalNode::start() calls.");
+  uint64_t cumulativeCount = 0;
+  for (std::size_t i = 0; i < NODE_START_BUCKET_COUNT; i += 1) {
+    cumulativeCount += Get(aTotals.nodeStartBuckets[i]);
+    const char* label = (i < std::size(NODE_START_BOUNDS)) ? NODE_START_BOUNDS[i].label : "+Inf";
+    AppendPrometheusSample(output, "ztcpp_node_start_duration_seconds_bucket", "le", label,
+                           std::to_string(cumulativeCount));
+  }
+  AppendPrometheusSample(output, "ztcpp_node_start_duration_seconds_sum", nullptr, nullptr,
+                         FormatSeconds(Get(aTotals.nodeStartMicroseconds)));
+  AppendPrometheusSample(output, "ztcpp_node_start_duration_seconds_count", nullptr, nullptr,
+                         std::to_string(Get(aTotals.nodeStartCount)));
+
+  return output;
+}
+
+std::string FormatJson(const Shard& aTotals, uint64_t aSocketsOpen) {
+  std::string output;
+  output.reserve(2048);
+
+  output += "{\"sockets_open\":" + std::to_string(aSocketsOpen);
+  output += ",\"sockets_opened_total\":" + std::to_string(Get(aTotals.socketsOpened));
+  output += ",\"bytes_sent_total\":" + std::to_string(Get(aTotals.bytesSent));
+  output += ",\"bytes_received_total\":" + std::to_string(Get(aTotals.bytesReceived));
+
+  output += ",\"errors_total\":{";
+  for (std::size_t i = 0; i < ERROR_CODE_COUNT; i += 1) {
+    output += (i > 0) ? ",\"" : "\"";
+    output += ERROR_CODE_NAMES[i];
+    output += "\":" + std::to_string(Get(aTotals.errors[i]));
+  }
+  output += '}';
+
+  output += ",\"events_total\":{";
+  for (std::size_t i = 0; i < EVENT_CATEGORY_COUNT; i += 1) {
+    output += (i > 0) ? ",\"" : "\"";
+    output += EVENT_CATEGORY_NAMES[i];
+    output += "\":" + std::to_string(Get(aTotals.events[i]));
+  }
+  output += '}';
+
+  output += ",\"node_start_duration_seconds\":{\"buckets\":{";
+  uint64_t cumulativeCount = 0;
+  for (std::size_t i = 0; i < NODE_START_BUCKET_COUNT; i += 1) {
+    cumulativeCount += Get(aTotals.nodeStartBuckets[i]);
+    output += (i > 0) ? ",\"" : "\"";
+    output += (i < std::size(NODE_START_BOUNDS)) ? NODE_START_BOUNDS[i].label : "+Inf";
+    output += "\":" + std::to_string(cumulativeCount);
+  }
+  output += "},\"sum\":" + FormatSeconds(Get(aTotals.nodeStartMicroseconds));
+  output += ",\"count\":" + std::to_string(Get(aTotals.nodeStartCount));
+  output += "}}\n";
+
+  return output;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// RECORDING                                                             //
+///////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+void RecordErrorMetric(ErrorCode::Enum aErrorCode) noexcept {
+  const auto index = static_cast<std::size_t>(aErrorCode);
+  if (index < ERROR_CODE_COUNT) {
+    Add(GetThreadShard().errors[index], 1);
+  }
+}
+
+void RecordSocketOpenedMetric() {
+  Add(GetThreadShard().socketsOpened, 1);
+}
+
+void RecordSocketClosedMetric() {
+  Add(GetThreadShard().socketsClosed, 1);
+}
+
+void RecordBytesSentMetric(uint64_t aByteCount) {
+  Add(GetThreadShard().bytesSent, aByteCount);
+}
+
+void RecordBytesReceivedMetric(uint64_t aByteCount) {
+  Add(GetThreadShard().bytesReceived, aByteCount);
+}
+
+void RecordEventMetric(int aEventCode) {
+  Add(GetThreadShard().events[GetEventCategory(aEventCode)], 1);
+}
+
+void RecordNodeStartMetric(std::chrono::steady_clock::duration aDuration) {
+  const auto microseconds = static_cast<uint64_t>(
+    std::max<std::chrono::microseconds::rep>(
+      std::chrono::duration_cast<std::chrono::microseconds>(aDuration).count(), 0));
+
+  std::size_t bucket = 0;
+  while (bucket < std::size(NODE_START_BOUNDS) && microseconds > NODE_START_BOUNDS[bucket].microseconds) {
+    bucket += 1;
+  }
+
+  auto& shard = GetThreadShard();
+  Add(shard.nodeStartBuckets[bucket], 1);
+  Add(shard.nodeStartCount, 1);
+  Add(shard.nodeStartMicroseconds, microseconds);
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////
+// METRICS                                                               //
+///////////////////////////////////////////////////////////////////////////
+
+std::string Metrics::toString(MetricsFormat aFormat) {
+  Shard totals;
+  GetRegistry().collect(totals);
+
+  // Opens and closes of a socket can happen on different threads, and the shards
+  // aren't read at exactly the same time, so the difference could be negative
+  const auto opened = Get(totals.socketsOpened);
+  const auto closed = Get(totals.socketsClosed);
+  const uint64_t socketsOpen = (opened > closed) ? (opened - closed) : 0;
+
+  return (aFormat == MetricsFormat::Json) ? FormatJson(totals, socketsOpen)
+                                          : FormatPrometheus(totals, socketsOpen);
+}
+
+Result<std::size_t> Metrics::write(MetricsFormat aFormat,
+                                   char* aBuffer,
+                                   std::size_t aBufferByteSize) {
+  if (aBuffer == nullptr) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aBuffer is null")};
+  }
+
+  const auto text = toString(aFormat);
+  if (text.size() > aBufferByteSize) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aBuffer is too small (" + std::to_string(text.size()) +
+                               " bytes are needed)")};
+  }
+  std::memcpy(aBuffer, text.data(), text.size());
+  return {text.size()};
+}
+
+EmptyResult Metrics::writeToFile(MetricsFormat aFormat, const std::string& aPath) {
+  return detail::WriteFileAtomically(aPath, toString(aFormat));
+}
+
+ZTCPP_NAMESPACE_END
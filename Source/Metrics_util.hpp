@@ -0,0 +1,32 @@
+#ifndef ZTCPP_METRICS_UTIL_HPP
+#define ZTCPP_METRICS_UTIL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+// Hooks through which the rest of the library feeds Metrics. All of them only
+// touch the calling thread's shard. (Errors are recorded through
+// RecordErrorMetric(), declared in Result.hpp.)
+
+void RecordSocketOpenedMetric();
+
+void RecordSocketClosedMetric();
+
+void RecordBytesSentMetric(uint64_t aByteCount);
+
+void RecordBytesReceivedMetric(uint64_t aByteCount);
+
+//! aEventCode is a raw ZTS_EVENT_* code.
+void RecordEventMetric(int aEventCode);
+
+void RecordNodeStartMetric(std::chrono::steady_clock::duration aDuration);
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_METRICS_UTIL_HPP
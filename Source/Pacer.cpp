@@ -0,0 +1,379 @@
+#include <ZTCpp/Pacer.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+using Clock = TokenBucket::Clock;
+
+//! When there are more peer buckets than this, the ones which are full (idle)
+//! and use the default rate are dropped before a new one is added.
+constexpr std::size_t PEER_BUCKET_PRUNE_THRESHOLD = 1024;
+
+struct IpAddressHash {
+  std::size_t operator()(const IpAddress& aIpAddress) const {
+    // FNV-1a
+    std::uint64_t hash = 14695981039346656037ull;
+    const auto mix = [&hash](const std::uint8_t* aBytes, std::size_t aCount) {
+      for (std::size_t i = 0; i < aCount; i += 1) {
+        hash ^= aBytes[i];
+        hash *= 1099511628211ull;
+      }
+    };
+    if (aIpAddress.getAddressFamily() == AddressFamily::IPv4) {
+      const auto address = aIpAddress.getIPv4AddressInNetworkOrder();
+      mix(reinterpret_cast<const std::uint8_t*>(&address), sizeof(address));
+    }
+    else {
+      const auto address = aIpAddress.getIPv6AddressInNetworkOrder();
+      mix(address.bytes, sizeof(address.bytes));
+    }
+    return static_cast<std::size_t>(hash);
+  }
+};
+
+std::chrono::milliseconds ToPollTimeout(Clock::duration aDuration) {
+  const auto result = std::chrono::ceil<std::chrono::milliseconds>(aDuration);
+  return (result.count() > 0) ? result : std::chrono::milliseconds{0};
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// TOKEN BUCKET                                                          //
+///////////////////////////////////////////////////////////////////////////
+
+TokenBucket::TokenBucket()
+  : TokenBucket{PacingRate::unlimited()}
+{
+}
+
+TokenBucket::TokenBucket(PacingRate aRate)
+  : _rate{aRate}
+  , _tokens{static_cast<double>(aRate.burstByteSize)}
+  , _lastRefillTime{Clock::now()}
+{
+}
+
+void TokenBucket::setRate(PacingRate aRate) {
+  const auto now = Clock::now();
+  refill(now);
+  const bool wasUnlimited = _rate.isUnlimited();
+  _rate = aRate;
+  _tokens = wasUnlimited ? static_cast<double>(aRate.burstByteSize)
+                         : std::min(_tokens, static_cast<double>(aRate.burstByteSize));
+}
+
+PacingRate TokenBucket::getRate() const {
+  return _rate;
+}
+
+bool TokenBucket::tryConsume(std::size_t aByteSize, Clock::time_point aNow) {
+  if (!isAllowed(aByteSize, aNow)) {
+    return false;
+  }
+  consume(aByteSize, aNow);
+  return true;
+}
+
+void TokenBucket::consume(std::size_t aByteSize, Clock::time_point aNow) {
+  if (_rate.isUnlimited()) {
+    return;
+  }
+  refill(aNow);
+  _tokens -= static_cast<double>(aByteSize);
+}
+
+bool TokenBucket::isAllowed(std::size_t aByteSize, Clock::time_point aNow) const {
+  if (_rate.isUnlimited()) {
+    return true;
+  }
+  return getTokens(aNow) >= getRequiredTokens(aByteSize);
+}
+
+Clock::duration TokenBucket::getTimeUntilAllowed(std::size_t aByteSize,
+                                                 Clock::time_point aNow) const {
+  if (_rate.isUnlimited()) {
+    return Clock::duration::zero();
+  }
+  const auto missingTokens = getRequiredTokens(aByteSize) - getTokens(aNow);
+  if (missingTokens <= 0.0) {
+    return Clock::duration::zero();
+  }
+  const std::chrono::duration<double> seconds{missingTokens / static_cast<double>(_rate.bytesPerSecond)};
+  return std::chrono::ceil<Clock::duration>(seconds);
+}
+
+bool TokenBucket::isFull(Clock::time_point aNow) const {
+  return _rate.isUnlimited() || getTokens(aNow) >= static_cast<double>(_rate.burstByteSize);
+}
+
+double TokenBucket::getTokens(Clock::time_point aNow) const {
+  if (aNow <= _lastRefillTime) {
+    return _tokens;
+  }
+  const std::chrono::duration<double> elapsed = aNow - _lastRefillTime;
+  return std::min(_tokens + elapsed.count() * static_cast<double>(_rate.bytesPerSecond),
+                  static_cast<double>(_rate.burstByteSize));
+}
+
+void TokenBucket::refill(Clock::time_point aNow) {
+  _tokens = getTokens(aNow);
+  _lastRefillTime = std::max(_lastRefillTime, aNow);
+}
+
+double TokenBucket::getRequiredTokens(std::size_t aByteSize) const {
+  // Sends larger than the burst only need a full bucket (and leave it in debt)
+  return static_cast<double>(std::min(aByteSize, _rate.burstByteSize));
+}
+
+///////////////////////////////////////////////////////////////////////////
+// PACER IMPL                                                            //
+///////////////////////////////////////////////////////////////////////////
+
+class Pacer::Impl {
+public:
+  Impl(Socket& aSocket, PacingRate aSocketRate)
+    : _socket{&aSocket}
+    , _socketBucket{aSocketRate}
+  {
+  }
+
+  void setSocketRate(PacingRate aRate) {
+    _socketBucket.setRate(aRate);
+  }
+
+  PacingRate getSocketRate() const {
+    return _socketBucket.getRate();
+  }
+
+  void setPeerRate(const IpAddress& aIpAddress, PacingRate aRate) {
+    auto iter = _peers.find(aIpAddress);
+    if (iter == _peers.end()) {
+      _peers.emplace(aIpAddress, PeerState{TokenBucket{aRate}, true});
+      return;
+    }
+    iter->second.bucket.setRate(aRate);
+    iter->second.hasOwnRate = true;
+  }
+
+  void resetPeerRate(const IpAddress& aIpAddress) {
+    auto iter = _peers.find(aIpAddress);
+    if (iter == _peers.end()) {
+      return;
+    }
+    if (_defaultPeerRate.isUnlimited()) {
+      _peers.erase(iter);
+      return;
+    }
+    iter->second.bucket.setRate(_defaultPeerRate);
+    iter->second.hasOwnRate = false;
+  }
+
+  void setDefaultPeerRate(PacingRate aRate) {
+    _defaultPeerRate = aRate;
+    for (auto iter = _peers.begin(); iter != _peers.end(); ) {
+      if (iter->second.hasOwnRate) {
+        ++iter;
+      }
+      else if (aRate.isUnlimited()) {
+        iter = _peers.erase(iter);
+      }
+      else {
+        iter->second.bucket.setRate(aRate);
+        ++iter;
+      }
+    }
+  }
+
+  PacingRate getDefaultPeerRate() const {
+    return _defaultPeerRate;
+  }
+
+  Result<std::size_t> send(const void* aData, std::size_t aDataByteSize, int aFlags) {
+    return pacedSend(aDataByteSize, getConnectedIpAddress(), [&]() {
+      return _socket->send(aData, aDataByteSize, aFlags);
+    });
+  }
+
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const IpAddress& aRemoteIpAddress,
+                             uint16_t aRemotePort) {
+    return pacedSend(aDataByteSize, aRemoteIpAddress, [&]() {
+      return _socket->sendTo(aData, aDataByteSize, aRemoteIpAddress, aRemotePort);
+    });
+  }
+
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const Endpoint& aRemoteEndpoint) {
+    return pacedSend(aDataByteSize, aRemoteEndpoint.getIpAddress(), [&]() {
+      return _socket->sendTo(aData, aDataByteSize, aRemoteEndpoint);
+    });
+  }
+
+  std::chrono::milliseconds getTimeUntilAllowed(std::size_t aByteSize) const {
+    return getTimeUntilAllowed(aByteSize, getConnectedIpAddress());
+  }
+
+  std::chrono::milliseconds getTimeUntilAllowed(std::size_t aByteSize,
+                                                const IpAddress& aRemoteIpAddress) const {
+    const auto now = Clock::now();
+    auto result = _socketBucket.getTimeUntilAllowed(aByteSize, now);
+    if (aRemoteIpAddress.isValid()) {
+      auto iter = _peers.find(aRemoteIpAddress);
+      if (iter != _peers.end()) {
+        result = std::max(result, iter->second.bucket.getTimeUntilAllowed(aByteSize, now));
+      }
+      // Otherwise the peer would get a new (full) bucket - no need to wait
+    }
+    return ToPollTimeout(result);
+  }
+
+  Socket& getSocket() const {
+    return *_socket;
+  }
+
+private:
+  struct PeerState {
+    TokenBucket bucket;
+    bool hasOwnRate;
+  };
+
+  //! Returns the address the socket is connected to, or an invalid address.
+  IpAddress getConnectedIpAddress() const {
+    auto res = _socket->getRemoteEndpoint();
+    return res ? (*res).getIpAddress() : IpAddress{};
+  }
+
+  //! Returns the bucket for aIpAddress (creating it if needed), or nullptr if
+  //! sending to that address is not limited.
+  TokenBucket* getPeerBucket(const IpAddress& aIpAddress, Clock::time_point aNow) {
+    if (!aIpAddress.isValid()) {
+      return nullptr;
+    }
+    auto iter = _peers.find(aIpAddress);
+    if (iter != _peers.end()) {
+      return &(iter->second.bucket);
+    }
+    if (_defaultPeerRate.isUnlimited()) {
+      return nullptr;
+    }
+    if (_peers.size() >= PEER_BUCKET_PRUNE_THRESHOLD) {
+      for (auto it = _peers.begin(); it != _peers.end(); ) {
+        if (!it->second.hasOwnRate && it->second.bucket.isFull(aNow)) {
+          it = _peers.erase(it);
+        }
+        else {
+          ++it;
+        }
+      }
+    }
+    iter = _peers.emplace(aIpAddress, PeerState{TokenBucket{_defaultPeerRate}, false}).first;
+    return &(iter->second.bucket);
+  }
+
+  template <class taSendFunc>
+  Result<std::size_t> pacedSend(std::size_t aDataByteSize,
+                                const IpAddress& aDestination,
+                                taSendFunc&& aSendFunc) {
+    const auto now = Clock::now();
+    TokenBucket* peerBucket = getPeerBucket(aDestination, now);
+    if (!_socketBucket.isAllowed(aDataByteSize, now) ||
+        (peerBucket != nullptr && !peerBucket->isAllowed(aDataByteSize, now))) {
+      detail::RecordErrorMetric(ErrorCode::WouldBlock);
+      return ResultWouldBlock();
+    }
+
+    auto res = aSendFunc();
+    if (res) {
+      _socketBucket.consume(*res, now);
+      if (peerBucket != nullptr) {
+        peerBucket->consume(*res, now);
+      }
+    }
+    return res;
+  }
+
+  Socket* _socket;
+  TokenBucket _socketBucket;
+  PacingRate _defaultPeerRate;
+  std::unordered_map<IpAddress, PeerState, IpAddressHash> _peers;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// PACER                                                                 //
+///////////////////////////////////////////////////////////////////////////
+
+Pacer::Pacer(Socket& aSocket, PacingRate aSocketRate)
+  : _impl{std::make_unique<Impl>(aSocket, aSocketRate)}
+{
+}
+
+Pacer::Pacer(Pacer&&) = default;
+
+Pacer& Pacer::operator=(Pacer&&) = default;
+
+Pacer::~Pacer() = default;
+
+void Pacer::setSocketRate(PacingRate aRate) {
+  _impl->setSocketRate(aRate);
+}
+
+PacingRate Pacer::getSocketRate() const {
+  return _impl->getSocketRate();
+}
+
+void Pacer::setPeerRate(const IpAddress& aIpAddress, PacingRate aRate) {
+  _impl->setPeerRate(aIpAddress, aRate);
+}
+
+void Pacer::resetPeerRate(const IpAddress& aIpAddress) {
+  _impl->resetPeerRate(aIpAddress);
+}
+
+void Pacer::setDefaultPeerRate(PacingRate aRate) {
+  _impl->setDefaultPeerRate(aRate);
+}
+
+PacingRate Pacer::getDefaultPeerRate() const {
+  return _impl->getDefaultPeerRate();
+}
+
+Result<std::size_t> Pacer::send(const void* aData,
+                                std::size_t aDataByteSize,
+                                int aFlags) {
+  return _impl->send(aData, aDataByteSize, aFlags);
+}
+
+Result<std::size_t> Pacer::sendTo(const void* aData,
+                                  std::size_t aDataByteSize,
+                                  const IpAddress& aRemoteIpAddress,
+                                  uint16_t aRemotePort) {
+  return _impl->sendTo(aData, aDataByteSize, aRemoteIpAddress, aRemotePort);
+}
+
+Result<std::size_t> Pacer::sendTo(const void* aData,
+                                  std::size_t aDataByteSize,
+                                  const Endpoint& aRemoteEndpoint) {
+  return _impl->sendTo(aData, aDataByteSize, aRemoteEndpoint);
+}
+
+std::chrono::milliseconds Pacer::getTimeUntilAllowed(std::size_t aByteSize) const {
+  return _impl->getTimeUntilAllowed(aByteSize);
+}
+
+std::chrono::milliseconds Pacer::getTimeUntilAllowed(std::size_t aByteSize,
+                                                     const IpAddress& aRemoteIpAddress) const {
+  return _impl->getTimeUntilAllowed(aByteSize, aRemoteIpAddress);
+}
+
+Socket& Pacer::getSocket() const {
+  return _impl->getSocket();
+}
+
+ZTCPP_NAMESPACE_END
@@ -0,0 +1,30 @@
+#include "Poll_util.hpp"
+
+#include <ZTCpp/Socket.hpp>
+
+#include <ZeroTierSockets.h>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+short ToZTPollEvents(int aPollEventBitmask) {
+  short result = 0;
+  result |= ((aPollEventBitmask & PollEventBitmask::ReadyToReceive) != 0)             ? ZTS_POLLIN  : 0;
+  result |= ((aPollEventBitmask & PollEventBitmask::ReadyToSend) != 0)                ? ZTS_POLLOUT : 0;
+  result |= ((aPollEventBitmask & PollEventBitmask::ReadyToReceivePriorityData) != 0) ? ZTS_POLLPRI : 0;
+  return result;
+}
+
+int FromZTPollEvents(short aZTPollEvents) {
+  int result = 0;
+  if (aZTPollEvents & ZTS_POLLIN)   result |= PollEventBitmask::ReadyToReceive;
+  if (aZTPollEvents & ZTS_POLLOUT)  result |= PollEventBitmask::ReadyToSend;
+  if (aZTPollEvents & ZTS_POLLPRI)  result |= PollEventBitmask::ReadyToReceivePriorityData;
+  if (aZTPollEvents & ZTS_POLLHUP)  result |= PollEventBitmask::HungUp;
+  if (aZTPollEvents & ZTS_POLLERR)  result |= PollEventBitmask::Error;
+  if (aZTPollEvents & ZTS_POLLNVAL) result |= PollEventBitmask::InvalidSocket;
+  return result;
+}
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
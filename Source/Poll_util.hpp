@@ -0,0 +1,20 @@
+#ifndef ZTCPP_POLL_UTIL_HPP
+#define ZTCPP_POLL_UTIL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+//! Convert a combination of PollEventBitmask::Enum values into a combination of
+//! ZTS_POLL* flags (suitable for zts_pollfd::events).
+short ToZTPollEvents(int aPollEventBitmask);
+
+//! Opposite of ToZTPollEvents (suitable for zts_pollfd::revents). Also maps
+//! ZTS_POLLHUP, ZTS_POLLERR and ZTS_POLLNVAL.
+int FromZTPollEvents(short aZTPollEvents);
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
+
+#endif // !ZTCPP_POLL_UTIL_HPP
@@ -0,0 +1,172 @@
+#include <ZTCpp/Poller.hpp>
+
+#include "Poll_util.hpp"
+#include "Tracing_util.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+#include <ZeroTierSockets.h>
+
+ZTCPP_NAMESPACE_BEGIN
+
+///////////////////////////////////////////////////////////////////////////
+// POLLER IMPL                                                           //
+///////////////////////////////////////////////////////////////////////////
+
+class Poller::Impl {
+public:
+  EmptyResult add(Socket& aSocket, PollEventBitmask::Enum aInterestedIn) {
+    if (!aSocket.isOpen()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aSocket is not open")};
+    }
+    const int socketID = detail::GetSocketID(aSocket);
+    if (_indices.find(socketID) != _indices.end()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aSocket is already registered")};
+    }
+
+    struct zts_pollfd pollfd;
+    pollfd.fd = socketID;
+    pollfd.events = detail::ToZTPollEvents(aInterestedIn);
+    pollfd.revents = 0;
+
+    _indices[socketID] = _pollfds.size();
+    _pollfds.push_back(pollfd);
+    _sockets.push_back(&aSocket);
+
+    return EmptyResultOK();
+  }
+
+  EmptyResult modify(Socket& aSocket, PollEventBitmask::Enum aInterestedIn) {
+    const auto iter = _indices.find(detail::GetSocketID(aSocket));
+    if (iter == _indices.end()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aSocket is not registered")};
+    }
+
+    _pollfds[iter->second].events = detail::ToZTPollEvents(aInterestedIn);
+    _sockets[iter->second] = &aSocket;
+
+    return EmptyResultOK();
+  }
+
+  EmptyResult remove(Socket& aSocket) {
+    const auto iter = _indices.find(detail::GetSocketID(aSocket));
+    if (iter == _indices.end()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aSocket is not registered")};
+    }
+
+    // Swap with the last element so the array stays contiguous
+    const std::size_t index = iter->second;
+    const std::size_t lastIndex = _pollfds.size() - 1;
+    if (index != lastIndex) {
+      _pollfds[index] = _pollfds[lastIndex];
+      _sockets[index] = _sockets[lastIndex];
+      _indices[_pollfds[index].fd] = index;
+    }
+    _pollfds.pop_back();
+    _sockets.pop_back();
+    _indices.erase(iter);
+
+    return EmptyResultOK();
+  }
+
+  bool contains(const Socket& aSocket) const {
+    return (_indices.find(detail::GetSocketID(aSocket)) != _indices.end());
+  }
+
+  std::size_t getSocketCount() const {
+    return _pollfds.size();
+  }
+
+  Result<std::size_t> wait(std::chrono::milliseconds aMaxTimeToWait) {
+    _readyEvents.clear();
+
+    const int pollres = ZTCPP_TRACE_CALL("zts_bsd_poll", -1, 0,
+                                         zts_bsd_poll(_pollfds.data(),
+                                                      static_cast<zts_nfds_t>(_pollfds.size()),
+                                                      static_cast<int>(aMaxTimeToWait.count())));
+
+    if (pollres == ZTS_ERR_SOCKET) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (pollres == ZTS_ERR_SERVICE) {
+      return {ZTCPP_ERROR_REPORT(ServiceError,
+                                 "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (pollres < 0) {
+      return {ZTCPP_ERROR_REPORT(GenericError,
+                                 "Unspecified error from zts_poll (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+
+    if (pollres > 0) {
+      _readyEvents.reserve(static_cast<std::size_t>(pollres));
+      for (std::size_t i = 0; i < _pollfds.size(); i += 1) {
+        if (_pollfds[i].revents != 0) {
+          _readyEvents.push_back({_sockets[i], detail::FromZTPollEvents(_pollfds[i].revents)});
+        }
+      }
+    }
+
+    return {_readyEvents.size()};
+  }
+
+  const std::vector<PollerEvent>& getReadyEvents() const {
+    return _readyEvents;
+  }
+
+private:
+  std::vector<struct zts_pollfd> _pollfds;   // Passed directly to zts_bsd_poll
+  std::vector<Socket*> _sockets;             // Parallel to _pollfds
+  std::unordered_map<int, std::size_t> _indices; // Socket ID -> index into _pollfds
+  std::vector<PollerEvent> _readyEvents;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// POLLER                                                                //
+///////////////////////////////////////////////////////////////////////////
+
+Poller::Poller()
+  : _impl{std::make_unique<Impl>()}
+{
+}
+
+Poller::~Poller() = default;
+
+Poller::Poller(Poller&&) = default;
+
+Poller& Poller::operator=(Poller&&) = default;
+
+EmptyResult Poller::add(Socket& aSocket, PollEventBitmask::Enum aInterestedIn) {
+  return _impl->add(aSocket, aInterestedIn);
+}
+
+EmptyResult Poller::modify(Socket& aSocket, PollEventBitmask::Enum aInterestedIn) {
+  return _impl->modify(aSocket, aInterestedIn);
+}
+
+EmptyResult Poller::remove(Socket& aSocket) {
+  return _impl->remove(aSocket);
+}
+
+bool Poller::contains(const Socket& aSocket) const {
+  return _impl->contains(aSocket);
+}
+
+std::size_t Poller::getSocketCount() const {
+  return _impl->getSocketCount();
+}
+
+Result<std::size_t> Poller::wait(std::chrono::milliseconds aMaxTimeToWait) {
+  return _impl->wait(aMaxTimeToWait);
+}
+
+const std::vector<PollerEvent>& Poller::getReadyEvents() const {
+  return _impl->getReadyEvents();
+}
+
+ZTCPP_NAMESPACE_END
@@ -0,0 +1,331 @@
+#include <ZTCpp/Reactor.hpp>
+#include <ZTCpp/Poller.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+using Clock = std::chrono::steady_clock;
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// REACTOR IMPL                                                          //
+///////////////////////////////////////////////////////////////////////////
+
+class Reactor::Impl {
+public:
+  explicit Impl(std::chrono::milliseconds aMaxIdleWaitTime)
+    : _maxIdleWaitTime{aMaxIdleWaitTime}
+  {
+  }
+
+  EmptyResult setReadHandler(Socket& aSocket, SocketHandler aHandler) {
+    auto& entry = getOrCreateEntry(aSocket);
+    entry->readHandler = std::move(aHandler);
+    entry->acceptHandler = nullptr;
+    return updateRegistration(aSocket);
+  }
+
+  EmptyResult setWriteHandler(Socket& aSocket, SocketHandler aHandler) {
+    auto& entry = getOrCreateEntry(aSocket);
+    entry->writeHandler = std::move(aHandler);
+    return updateRegistration(aSocket);
+  }
+
+  EmptyResult setAcceptHandler(Socket& aListener, AcceptHandler aHandler) {
+    auto& entry = getOrCreateEntry(aListener);
+    entry->acceptHandler = std::move(aHandler);
+    entry->readHandler = nullptr;
+    return updateRegistration(aListener);
+  }
+
+  void removeSocket(Socket& aSocket) {
+    if (_entries.erase(&aSocket) > 0) {
+      (void)_poller.remove(aSocket);
+    }
+  }
+
+  std::size_t getSocketCount() const {
+    return _entries.size();
+  }
+
+  TimerID addTimer(std::chrono::milliseconds aDelay,
+                   std::chrono::milliseconds aInterval,
+                   TimerHandler aHandler) {
+    const TimerID id = _nextTimerID;
+    _nextTimerID += 1;
+    _timers[id] = Timer{aInterval, std::move(aHandler)};
+    _timerQueue.push(TimerQueueEntry{Clock::now() + aDelay, id});
+    return id;
+  }
+
+  bool cancelTimer(TimerID aTimerID) {
+    // The entry in _timerQueue is discarded lazily once it expires
+    return (_timers.erase(aTimerID) > 0);
+  }
+
+  EmptyResult runOnce(std::chrono::milliseconds aMaxTimeToWait) {
+    auto timeToWait = (aMaxTimeToWait.count() < 0) ? _maxIdleWaitTime : aMaxTimeToWait;
+    discardCancelledTimers();
+    if (!_timerQueue.empty()) {
+      const auto untilNextTimer = std::chrono::ceil<std::chrono::milliseconds>(
+        _timerQueue.top().deadline - Clock::now());
+      if (untilNextTimer < timeToWait) {
+        timeToWait = std::max(untilNextTimer, std::chrono::milliseconds{0});
+      }
+    }
+
+    if (_poller.getSocketCount() > 0) {
+      const auto waitResult = _poller.wait(timeToWait);
+      if (!waitResult) {
+        return {std::make_unique<ErrorReport>(waitResult.getError())};
+      }
+      // Copy the events because handlers may modify the poller
+      _dispatchQueue = _poller.getReadyEvents();
+      dispatchSocketEvents();
+    }
+    else if (timeToWait.count() > 0) {
+      std::this_thread::sleep_for(timeToWait);
+    }
+
+    dispatchTimers();
+    return EmptyResultOK();
+  }
+
+  EmptyResult run() {
+    while (!_stopRequested.exchange(false)) {
+      auto res = runOnce(std::chrono::milliseconds{-1});
+      if (!res) {
+        return res;
+      }
+    }
+    return EmptyResultOK();
+  }
+
+  void stop() {
+    _stopRequested.store(true);
+  }
+
+private:
+  struct Entry {
+    SocketHandler readHandler;
+    SocketHandler writeHandler;
+    AcceptHandler acceptHandler;
+  };
+
+  struct Timer {
+    std::chrono::milliseconds interval; // 0 for one-shot timers
+    TimerHandler handler;
+  };
+
+  struct TimerQueueEntry {
+    Clock::time_point deadline;
+    TimerID id;
+
+    bool operator>(const TimerQueueEntry& aOther) const {
+      return deadline > aOther.deadline;
+    }
+  };
+
+  std::shared_ptr<Entry>& getOrCreateEntry(Socket& aSocket) {
+    auto& entry = _entries[&aSocket];
+    if (!entry) {
+      entry = std::make_shared<Entry>();
+    }
+    return entry;
+  }
+
+  //! Bring the poller in sync with the handlers set for aSocket.
+  EmptyResult updateRegistration(Socket& aSocket) {
+    const auto iter = _entries.find(&aSocket);
+    const auto& entry = *iter->second;
+
+    int interest = 0;
+    if (entry.readHandler || entry.acceptHandler) {
+      interest |= PollEventBitmask::ReadyToReceive;
+    }
+    if (entry.writeHandler) {
+      interest |= PollEventBitmask::ReadyToSend;
+    }
+
+    if (interest == 0) {
+      _entries.erase(iter);
+      if (_poller.contains(aSocket)) {
+        return _poller.remove(aSocket);
+      }
+      return EmptyResultOK();
+    }
+
+    const auto interestEnum = static_cast<PollEventBitmask::Enum>(interest);
+    auto res = _poller.contains(aSocket) ? _poller.modify(aSocket, interestEnum)
+                                         : _poller.add(aSocket, interestEnum);
+    if (!res) {
+      _entries.erase(iter);
+    }
+    return res;
+  }
+
+  void dispatchSocketEvents() {
+    constexpr int ERROR_EVENTS = PollEventBitmask::HungUp | PollEventBitmask::Error |
+                                 PollEventBitmask::InvalidSocket;
+
+    for (const auto& event : _dispatchQueue) {
+      // Sockets are only ever looked up by address (never dereferenced before
+      // that), because an earlier handler could have removed and destroyed them
+      auto iter = _entries.find(event.socket);
+      if (iter == _entries.end()) {
+        continue;
+      }
+      // Keep the handlers alive even if they remove the socket
+      const std::shared_ptr<Entry> entry = iter->second;
+      Socket& socket = *event.socket;
+
+      // Handlers are always invoked through copies, because a handler may replace
+      // (and thus destroy) itself or the other handlers of its socket
+      if (entry->acceptHandler && (event.events & (PollEventBitmask::ReadyToAccept | ERROR_EVENTS))) {
+        auto acceptResult = socket.accept();
+        if (!acceptResult.wouldBlock()) {
+          const AcceptHandler handler = entry->acceptHandler;
+          handler(socket, std::move(acceptResult));
+        }
+      }
+      else if (entry->readHandler &&
+               (event.events & (PollEventBitmask::ReadyToReceiveAny | ERROR_EVENTS))) {
+        const SocketHandler handler = entry->readHandler;
+        handler(socket, event.events);
+      }
+
+      if (!entry->writeHandler || _entries.count(event.socket) == 0) {
+        continue;
+      }
+      if ((event.events & PollEventBitmask::ReadyToSend) ||
+          (!entry->readHandler && !entry->acceptHandler && (event.events & ERROR_EVENTS))) {
+        const SocketHandler handler = entry->writeHandler;
+        handler(socket, event.events);
+      }
+    }
+    _dispatchQueue.clear();
+  }
+
+  void discardCancelledTimers() {
+    while (!_timerQueue.empty() && _timers.count(_timerQueue.top().id) == 0) {
+      _timerQueue.pop();
+    }
+  }
+
+  void dispatchTimers() {
+    const auto now = Clock::now();
+    while (!_timerQueue.empty() && _timerQueue.top().deadline <= now) {
+      const auto expired = _timerQueue.top();
+      _timerQueue.pop();
+
+      auto iter = _timers.find(expired.id);
+      if (iter == _timers.end()) {
+        continue; // Cancelled
+      }
+
+      // Take the handler out of the map for the duration of the call, because
+      // the handler may cancel (and thus destroy) its own timer
+      TimerHandler handler = std::move(iter->second.handler);
+      const auto interval = iter->second.interval;
+      if (interval.count() == 0) {
+        _timers.erase(iter);
+        handler();
+        continue;
+      }
+
+      handler();
+      iter = _timers.find(expired.id);
+      if (iter != _timers.end()) {
+        iter->second.handler = std::move(handler);
+        // Don't try to catch up if we fell behind by more than one interval
+        auto nextDeadline = expired.deadline + interval;
+        if (nextDeadline <= now) {
+          nextDeadline = now + interval;
+        }
+        _timerQueue.push(TimerQueueEntry{nextDeadline, expired.id});
+      }
+    }
+  }
+
+  Poller _poller;
+  std::unordered_map<Socket*, std::shared_ptr<Entry>> _entries;
+  std::vector<PollerEvent> _dispatchQueue;
+
+  std::unordered_map<TimerID, Timer> _timers;
+  std::priority_queue<TimerQueueEntry,
+                      std::vector<TimerQueueEntry>,
+                      std::greater<TimerQueueEntry>> _timerQueue;
+  TimerID _nextTimerID = 1;
+
+  std::chrono::milliseconds _maxIdleWaitTime;
+  std::atomic<bool> _stopRequested{false};
+};
+
+///////////////////////////////////////////////////////////////////////////
+// REACTOR                                                               //
+///////////////////////////////////////////////////////////////////////////
+
+Reactor::Reactor(std::chrono::milliseconds aMaxIdleWaitTime)
+  : _impl{std::make_unique<Impl>(aMaxIdleWaitTime)}
+{
+}
+
+Reactor::~Reactor() = default;
+
+EmptyResult Reactor::setReadHandler(Socket& aSocket, SocketHandler aHandler) {
+  return _impl->setReadHandler(aSocket, std::move(aHandler));
+}
+
+EmptyResult Reactor::setWriteHandler(Socket& aSocket, SocketHandler aHandler) {
+  return _impl->setWriteHandler(aSocket, std::move(aHandler));
+}
+
+EmptyResult Reactor::setAcceptHandler(Socket& aListener, AcceptHandler aHandler) {
+  return _impl->setAcceptHandler(aListener, std::move(aHandler));
+}
+
+void Reactor::removeSocket(Socket& aSocket) {
+  _impl->removeSocket(aSocket);
+}
+
+std::size_t Reactor::getSocketCount() const {
+  return _impl->getSocketCount();
+}
+
+Reactor::TimerID Reactor::addTimer(std::chrono::milliseconds aDelay, TimerHandler aHandler) {
+  return _impl->addTimer(aDelay, std::chrono::milliseconds{0}, std::move(aHandler));
+}
+
+Reactor::TimerID Reactor::addPeriodicTimer(std::chrono::milliseconds aInterval,
+                                           TimerHandler aHandler) {
+  if (aInterval.count() <= 0) {
+    aInterval = std::chrono::milliseconds{1};
+  }
+  return _impl->addTimer(aInterval, aInterval, std::move(aHandler));
+}
+
+bool Reactor::cancelTimer(TimerID aTimerID) {
+  return _impl->cancelTimer(aTimerID);
+}
+
+EmptyResult Reactor::runOnce(std::chrono::milliseconds aMaxTimeToWait) {
+  return _impl->runOnce(aMaxTimeToWait);
+}
+
+EmptyResult Reactor::run() {
+  return _impl->run();
+}
+
+void Reactor::stop() {
+  _impl->stop();
+}
+
+ZTCPP_NAMESPACE_END
@@ -0,0 +1,627 @@
+#include <ZTCpp/Reliable_channel.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Datagram layout (all integers in network byte order):
+//   0  u8   packet type
+//   1  u8   flags
+//   2  u16  reserved (0)
+//   4  u32  ACK: every message with a lower sequence number was received
+//   8  u32  SACK bits: if bit N is set, message (ACK + 1 + N) was received
+//  12  u32  sequence number                     [DATA packets only]
+//  16  u32  ordered sequence number (if ordered) [DATA packets only]
+//  20  ...  message                              [DATA packets only]
+constexpr unsigned char PACKET_TYPE_DATA = 1;
+constexpr unsigned char PACKET_TYPE_ACK  = 2;
+constexpr unsigned char FLAG_UNORDERED   = 0x01;
+constexpr std::size_t ACK_PACKET_BYTE_SIZE = 12;
+
+//! Largest UDP payload over IPv4 (65535 - 8 byte UDP header - 20 byte IP header).
+constexpr std::size_t MAX_DATAGRAM_BYTE_SIZE = 65507;
+
+//! Maximum distance (in sequence numbers) ahead of the next expected message
+//! at which messages are accepted; also bounds the sender's in-flight window.
+constexpr std::uint32_t RECEIVE_WINDOW = 4096;
+
+//! A message is retransmitted early after this many ACKs that report later
+//! messages as received while it's still missing.
+constexpr unsigned FAST_RETRANSMIT_THRESHOLD = 3;
+
+constexpr double INITIAL_CONGESTION_WINDOW = 4.0;
+constexpr double MIN_SLOW_START_THRESHOLD = 2.0;
+
+//! G in RFC 6298.
+constexpr std::chrono::microseconds CLOCK_GRANULARITY{1000};
+
+void Store32(std::uint32_t aValue, unsigned char* aDestination) {
+  aDestination[0] = static_cast<unsigned char>((aValue >> 24) & 0xFF);
+  aDestination[1] = static_cast<unsigned char>((aValue >> 16) & 0xFF);
+  aDestination[2] = static_cast<unsigned char>((aValue >>  8) & 0xFF);
+  aDestination[3] = static_cast<unsigned char>((aValue >>  0) & 0xFF);
+}
+
+std::uint32_t Load32(const unsigned char* aSource) {
+  return (static_cast<std::uint32_t>(aSource[0]) << 24) |
+         (static_cast<std::uint32_t>(aSource[1]) << 16) |
+         (static_cast<std::uint32_t>(aSource[2]) <<  8) |
+         (static_cast<std::uint32_t>(aSource[3]) <<  0);
+}
+
+//! Serial number comparison (RFC 1982), so that sequence numbers can wrap around.
+bool SeqLess(std::uint32_t aLeft, std::uint32_t aRight) {
+  return static_cast<std::int32_t>(aLeft - aRight) < 0;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// RELIABLE CHANNEL IMPL                                                 //
+///////////////////////////////////////////////////////////////////////////
+
+class ReliableChannel::Impl {
+public:
+  Impl(Socket& aSocket, const Endpoint& aRemoteEndpoint, const Config& aConfig)
+    : _socket{&aSocket}
+    , _remoteEndpoint{aRemoteEndpoint}
+    , _config{aConfig}
+    , _lossGenerator{aConfig.simulatedLossSeed}
+  {
+    _config.maxMessageByteSize = std::min<std::size_t>(_config.maxMessageByteSize,
+                                                       MAX_DATAGRAM_BYTE_SIZE - HEADER_BYTE_SIZE);
+    _config.maxCongestionWindow = std::clamp<std::size_t>(_config.maxCongestionWindow,
+                                                          1, RECEIVE_WINDOW);
+    _config.maxTransmissionCount = std::max(_config.maxTransmissionCount, 1u);
+    _config.simulatedLossRate = std::clamp(_config.simulatedLossRate, 0.0, 1.0);
+
+    _congestionWindow = std::min(INITIAL_CONGESTION_WINDOW,
+                                 static_cast<double>(_config.maxCongestionWindow));
+    _slowStartThreshold = static_cast<double>(_config.maxCongestionWindow);
+    _retransmissionTimeout = std::clamp<std::chrono::microseconds>(
+      _config.initialRetransmissionTimeout,
+      _config.minRetransmissionTimeout,
+      _config.maxRetransmissionTimeout);
+
+    // One extra byte to detect datagrams that are too large
+    _datagramBuffer.resize(HEADER_BYTE_SIZE + _config.maxMessageByteSize + 1);
+  }
+
+  EmptyResult sendMessage(const void* aData,
+                          std::size_t aDataByteSize,
+                          MessageOrdering aOrdering) {
+    if (_failed) {
+      return makeFailureError();
+    }
+    if (aData == nullptr && aDataByteSize != 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aData is null")};
+    }
+    if (aDataByteSize > _config.maxMessageByteSize) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "Message is larger than the maximum message size (" +
+                                 std::to_string(_config.maxMessageByteSize) + " bytes)")};
+    }
+    if (getPendingMessageCount() >= _config.maxPendingMessages) {
+      detail::RecordErrorMetric(ErrorCode::WouldBlock);
+      return ResultWouldBlock();
+    }
+
+    const bool isOrdered = (aOrdering == MessageOrdering::Ordered);
+
+    OutgoingMessage message;
+    message.sequenceNumber = _nextSequenceNumber++;
+    message.datagram.resize(HEADER_BYTE_SIZE + aDataByteSize);
+    unsigned char* header = message.datagram.data();
+    header[0] = PACKET_TYPE_DATA;
+    header[1] = isOrdered ? 0 : FLAG_UNORDERED;
+    header[2] = 0;
+    header[3] = 0;
+    // ACK fields are filled in on each transmission
+    Store32(message.sequenceNumber, header + 12);
+    Store32(isOrdered ? _nextOrderedSequenceNumber++ : 0, header + 16);
+    if (aDataByteSize > 0) {
+      std::memcpy(header + HEADER_BYTE_SIZE, aData, aDataByteSize);
+    }
+
+    _queuedMessages.push_back(std::move(message));
+    // The message is accepted once it's queued: if sending fails, it's retransmitted
+    // later and update() reports the socket error (returning the error here would
+    // make callers who retry send the message twice)
+    (void)sendQueuedMessages(Clock::now());
+    return EmptyResultOK();
+  }
+
+  EmptyResult update() {
+    if (_failed) {
+      return makeFailureError();
+    }
+
+    const auto now = Clock::now();
+
+    // Receive everything that's waiting
+    while (true) {
+      Endpoint sender;
+      bool truncated = false;
+      auto res = _socket->receiveFrom(_datagramBuffer.data(), _datagramBuffer.size(),
+                                      sender, IoFlags::DontWait, &truncated);
+      if (res.wouldBlock()) {
+        break;
+      }
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      if (truncated || *res == _datagramBuffer.size() || sender != _remoteEndpoint) {
+        continue;
+      }
+      processDatagram(_datagramBuffer.data(), *res, now);
+    }
+
+    // Retransmit messages whose timers expired (or which were marked for fast
+    // retransmission while processing ACKs) - but no more of them than the
+    // congestion window allows, which after a timeout is a single message. The
+    // rest stay due and go out in later passes, as ACKs open the window again
+    std::size_t retransmissionCount = 0;
+    _retransmissionsDeferred = false;
+    for (auto& message : _inFlightMessages) {
+      if (message.acknowledged || now < message.retransmitTime) {
+        continue;
+      }
+      if (retransmissionCount >= getCongestionWindowSize()) {
+        _retransmissionsDeferred = true;
+        break;
+      }
+      if (message.transmissionCount >= _config.maxTransmissionCount) {
+        _failed = true;
+        _failureMessage = "Message #" + std::to_string(message.sequenceNumber) +
+                          " was not acknowledged after " +
+                          std::to_string(message.transmissionCount) + " transmissions";
+        return makeFailureError();
+      }
+      onMessageLost(message.sequenceNumber, !message.fastRetransmitPending);
+      message.fastRetransmitPending = false;
+      _statistics.retransmissions += 1;
+      retransmissionCount += 1;
+      auto res = transmit(message, now);
+      if (!res) {
+        return res;
+      }
+    }
+
+    auto res = sendQueuedMessages(now);
+    if (!res) {
+      return res;
+    }
+
+    if (now >= _ackDueTime) {
+      return sendAck();
+    }
+    return EmptyResultOK();
+  }
+
+  Result<MessageView> receiveMessage() {
+    if (_deliveredMessages.empty()) {
+      detail::RecordErrorMetric(ErrorCode::WouldBlock);
+      return ResultWouldBlock();
+    }
+    _currentMessage = std::move(_deliveredMessages.front());
+    _deliveredMessages.pop_front();
+    return {MessageView{_currentMessage.data(), _currentMessage.size()}};
+  }
+
+  bool hasReceivedMessage() const {
+    return !_deliveredMessages.empty();
+  }
+
+  std::chrono::milliseconds getTimeUntilNextUpdate() const {
+    // Retransmissions held back by the congestion window aren't due until an
+    // ACK arrives (which is noticed by polling the socket) or until the timer of
+    // a message that was sent expires
+    const auto now = Clock::now();
+    auto earliest = _ackDueTime;
+    for (const auto& message : _inFlightMessages) {
+      if (message.acknowledged || (_retransmissionsDeferred && message.retransmitTime <= now)) {
+        continue;
+      }
+      earliest = std::min(earliest, message.retransmitTime);
+    }
+    if (earliest == Clock::time_point::max()) {
+      return std::chrono::milliseconds{-1};
+    }
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(earliest - now);
+    return (remaining.count() > 0) ? remaining : std::chrono::milliseconds{0};
+  }
+
+  std::size_t getPendingMessageCount() const {
+    return _unacknowledgedCount + _queuedMessages.size();
+  }
+
+  const Endpoint& getRemoteEndpoint() const {
+    return _remoteEndpoint;
+  }
+
+  Statistics getStatistics() const {
+    Statistics result = _statistics;
+    result.smoothedRoundTripTime = _smoothedRoundTripTime;
+    result.roundTripTimeVariation = _roundTripTimeVariation;
+    result.retransmissionTimeout = _retransmissionTimeout;
+    result.congestionWindow = _congestionWindow;
+    result.messagesInFlight = _unacknowledgedCount;
+    result.messagesQueued = _queuedMessages.size();
+    return result;
+  }
+
+private:
+  struct OutgoingMessage {
+    std::vector<unsigned char> datagram; // Header + message
+    std::uint32_t sequenceNumber = 0;
+    Clock::time_point lastSendTime;
+    Clock::time_point retransmitTime;
+    unsigned transmissionCount = 0;
+    unsigned skipCount = 0;              // ACKs which reported later messages as received
+    bool acknowledged = false;
+    bool fastRetransmitPending = false;
+    bool fastRetransmitted = false;
+  };
+
+  ///// RECEIVING /////
+
+  void processDatagram(const unsigned char* aDatagram, std::size_t aByteSize, Clock::time_point aNow) {
+    if (aByteSize < ACK_PACKET_BYTE_SIZE) {
+      return;
+    }
+    const auto packetType = aDatagram[0];
+    if (packetType != PACKET_TYPE_DATA && packetType != PACKET_TYPE_ACK) {
+      return;
+    }
+
+    processAck(Load32(aDatagram + 4), Load32(aDatagram + 8), aNow);
+
+    if (packetType != PACKET_TYPE_DATA || aByteSize < HEADER_BYTE_SIZE) {
+      return;
+    }
+
+    const auto sequenceNumber = Load32(aDatagram + 12);
+    const std::uint32_t offset = sequenceNumber - _nextExpectedSequenceNumber;
+    if (offset >= RECEIVE_WINDOW) {
+      if (SeqLess(sequenceNumber, _nextExpectedSequenceNumber)) {
+        // Already received - our ACK was probably lost, so send another one
+        _statistics.duplicatesReceived += 1;
+        _ackDueTime = aNow;
+      }
+      // Otherwise it's too far ahead; drop it, the sender will retransmit it
+      return;
+    }
+    if (offset < _receivedAhead.size() && _receivedAhead[offset]) {
+      _statistics.duplicatesReceived += 1;
+      _ackDueTime = aNow;
+      return;
+    }
+
+    if (offset >= _receivedAhead.size()) {
+      _receivedAhead.resize(offset + 1, false);
+    }
+    _receivedAhead[offset] = true;
+    while (!_receivedAhead.empty() && _receivedAhead.front()) {
+      _receivedAhead.pop_front();
+      _nextExpectedSequenceNumber += 1;
+    }
+    _statistics.messagesReceived += 1;
+
+    // ACK right away if there's a gap (so the sender learns about the loss
+    // quickly), otherwise give the ACK a chance to be sent along with data
+    if (!_receivedAhead.empty()) {
+      _ackDueTime = aNow;
+    }
+    else {
+      _ackDueTime = std::min(_ackDueTime, aNow + _config.ackDelay);
+    }
+
+    std::vector<unsigned char> message{aDatagram + HEADER_BYTE_SIZE, aDatagram + aByteSize};
+    if ((aDatagram[1] & FLAG_UNORDERED) != 0) {
+      _deliveredMessages.push_back(std::move(message));
+      return;
+    }
+
+    const std::uint32_t orderedOffset = Load32(aDatagram + 16) - _nextOrderedSequenceNumberToDeliver;
+    if (orderedOffset >= RECEIVE_WINDOW) {
+      return; // Can't happen with a well-behaved peer
+    }
+    if (orderedOffset >= _heldOrderedMessages.size()) {
+      _heldOrderedMessages.resize(orderedOffset + 1);
+    }
+    _heldOrderedMessages[orderedOffset] = std::move(message);
+    while (!_heldOrderedMessages.empty() && _heldOrderedMessages.front().has_value()) {
+      _deliveredMessages.push_back(std::move(*_heldOrderedMessages.front()));
+      _heldOrderedMessages.pop_front();
+      _nextOrderedSequenceNumberToDeliver += 1;
+    }
+  }
+
+  std::uint32_t getAckBits() const {
+    std::uint32_t result = 0;
+    const auto count = std::min<std::size_t>(_receivedAhead.size(), 33);
+    for (std::size_t i = 1; i < count; i += 1) {
+      if (_receivedAhead[i]) {
+        result |= (1u << (i - 1));
+      }
+    }
+    return result;
+  }
+
+  ///// SENDING /////
+
+  void processAck(std::uint32_t aAck, std::uint32_t aAckBits, Clock::time_point aNow) {
+    if (_inRecovery && !SeqLess(aAck, _recoverySequenceNumber)) {
+      _inRecovery = false;
+    }
+    if (_inFlightMessages.empty()) {
+      return;
+    }
+
+    // The highest message which the peer reports as received out of order
+    bool hasSelectiveAck = false;
+    std::uint32_t highestSelectiveAck = 0;
+    for (int bit = 31; bit >= 0; bit -= 1) {
+      if ((aAckBits >> bit) & 1u) {
+        hasSelectiveAck = true;
+        highestSelectiveAck = aAck + 1 + static_cast<std::uint32_t>(bit);
+        break;
+      }
+    }
+
+    for (auto& message : _inFlightMessages) {
+      if (message.acknowledged) {
+        continue;
+      }
+      const std::uint32_t offset = message.sequenceNumber - aAck;
+      const bool received = SeqLess(message.sequenceNumber, aAck) ||
+                            (offset >= 1 && offset <= 32 && ((aAckBits >> (offset - 1)) & 1u));
+      if (received) {
+        onMessageAcknowledged(message, aNow);
+        continue;
+      }
+      if (hasSelectiveAck && SeqLess(message.sequenceNumber, highestSelectiveAck)) {
+        message.skipCount += 1;
+        if (message.skipCount >= FAST_RETRANSMIT_THRESHOLD && !message.fastRetransmitted) {
+          // Picked up by the retransmission pass in update()
+          message.fastRetransmitted = true;
+          message.fastRetransmitPending = true;
+          message.retransmitTime = aNow;
+        }
+      }
+    }
+
+    while (!_inFlightMessages.empty() && _inFlightMessages.front().acknowledged) {
+      _inFlightMessages.pop_front();
+    }
+  }
+
+  void onMessageAcknowledged(OutgoingMessage& aMessage, Clock::time_point aNow) {
+    aMessage.acknowledged = true;
+    std::vector<unsigned char>{}.swap(aMessage.datagram);
+    _unacknowledgedCount -= 1;
+
+    // Karn's algorithm: only unambiguous samples are used
+    if (aMessage.transmissionCount == 1) {
+      updateRoundTripTime(std::chrono::duration_cast<std::chrono::microseconds>(
+        aNow - aMessage.lastSendTime));
+    }
+
+    // Slow start, then additive increase
+    if (_congestionWindow < _slowStartThreshold) {
+      _congestionWindow += 1.0;
+    }
+    else {
+      _congestionWindow += 1.0 / _congestionWindow;
+    }
+    _congestionWindow = std::min(_congestionWindow, static_cast<double>(_config.maxCongestionWindow));
+  }
+
+  //! RFC 6298, section 2.
+  void updateRoundTripTime(std::chrono::microseconds aSample) {
+    if (!_hasRoundTripTimeSample) {
+      _smoothedRoundTripTime = aSample;
+      _roundTripTimeVariation = aSample / 2;
+      _hasRoundTripTimeSample = true;
+    }
+    else {
+      const auto difference = (_smoothedRoundTripTime > aSample) ? (_smoothedRoundTripTime - aSample)
+                                                                 : (aSample - _smoothedRoundTripTime);
+      _roundTripTimeVariation = (3 * _roundTripTimeVariation + difference) / 4;
+      _smoothedRoundTripTime = (7 * _smoothedRoundTripTime + aSample) / 8;
+    }
+    _retransmissionTimeout = std::clamp<std::chrono::microseconds>(
+      _smoothedRoundTripTime + std::max(CLOCK_GRANULARITY, 4 * _roundTripTimeVariation),
+      _config.minRetransmissionTimeout,
+      _config.maxRetransmissionTimeout);
+  }
+
+  //! Multiplicative decrease - at most once per window of data.
+  void onMessageLost(std::uint32_t aSequenceNumber, bool aTimedOut) {
+    if (_inRecovery && SeqLess(aSequenceNumber, _recoverySequenceNumber)) {
+      return;
+    }
+    _inRecovery = true;
+    _recoverySequenceNumber = _nextSequenceNumber;
+    _slowStartThreshold = std::max(_congestionWindow / 2.0, MIN_SLOW_START_THRESHOLD);
+    _congestionWindow = aTimedOut ? 1.0 : _slowStartThreshold;
+  }
+
+  std::size_t getCongestionWindowSize() const {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(_congestionWindow));
+  }
+
+  EmptyResult sendQueuedMessages(Clock::time_point aNow) {
+    const auto window = getCongestionWindowSize();
+    while (!_queuedMessages.empty() &&
+           _unacknowledgedCount < window &&
+           _inFlightMessages.size() < RECEIVE_WINDOW) {
+      _inFlightMessages.push_back(std::move(_queuedMessages.front()));
+      _queuedMessages.pop_front();
+      _unacknowledgedCount += 1;
+      _statistics.messagesSent += 1;
+      auto res = transmit(_inFlightMessages.back(), aNow);
+      if (!res) {
+        return res;
+      }
+    }
+    return EmptyResultOK();
+  }
+
+  EmptyResult transmit(OutgoingMessage& aMessage, Clock::time_point aNow) {
+    Store32(_nextExpectedSequenceNumber, aMessage.datagram.data() + 4);
+    Store32(getAckBits(), aMessage.datagram.data() + 8);
+    _ackDueTime = Clock::time_point::max(); // The ACK goes along with the message
+
+    aMessage.lastSendTime = aNow;
+    aMessage.transmissionCount += 1;
+    // Exponential backoff for each retransmission
+    const auto backoffShift = std::min(aMessage.transmissionCount - 1, 16u);
+    const auto timeout = std::min<std::chrono::microseconds>(
+      _retransmissionTimeout * (1 << backoffShift),
+      _config.maxRetransmissionTimeout);
+    aMessage.retransmitTime = aNow + timeout;
+
+    return sendDatagram(aMessage.datagram.data(), aMessage.datagram.size());
+  }
+
+  EmptyResult sendAck() {
+    unsigned char packet[ACK_PACKET_BYTE_SIZE];
+    packet[0] = PACKET_TYPE_ACK;
+    packet[1] = 0;
+    packet[2] = 0;
+    packet[3] = 0;
+    Store32(_nextExpectedSequenceNumber, packet + 4);
+    Store32(getAckBits(), packet + 8);
+    _ackDueTime = Clock::time_point::max();
+    return sendDatagram(packet, sizeof(packet));
+  }
+
+  EmptyResult sendDatagram(const void* aData, std::size_t aDataByteSize) {
+    if (_config.simulatedLossRate > 0.0 && _lossDistribution(_lossGenerator) < _config.simulatedLossRate) {
+      return EmptyResultOK();
+    }
+    auto res = _socket->sendTo(aData, aDataByteSize, _remoteEndpoint);
+    if (res.wouldBlock()) {
+      return EmptyResultOK(); // Same as if the datagram was lost on the way
+    }
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return EmptyResultOK();
+  }
+
+  EmptyResult makeFailureError() const {
+    return {ZTCPP_ERROR_REPORT(SocketError, _failureMessage)};
+  }
+
+  Socket* _socket;
+  Endpoint _remoteEndpoint;
+  Config _config;
+
+  // Sending
+  std::deque<OutgoingMessage> _queuedMessages;   // Waiting for the congestion window
+  std::deque<OutgoingMessage> _inFlightMessages; // In order of sequence numbers
+  std::size_t _unacknowledgedCount = 0;
+  std::uint32_t _nextSequenceNumber = 0;
+  std::uint32_t _nextOrderedSequenceNumber = 0;
+
+  // Congestion control
+  double _congestionWindow;
+  double _slowStartThreshold;
+  bool _inRecovery = false;
+  std::uint32_t _recoverySequenceNumber = 0;
+  bool _retransmissionsDeferred = false; // By the last retransmission pass
+
+  // Round-trip time estimation
+  bool _hasRoundTripTimeSample = false;
+  std::chrono::microseconds _smoothedRoundTripTime{0};
+  std::chrono::microseconds _roundTripTimeVariation{0};
+  std::chrono::microseconds _retransmissionTimeout;
+
+  // Receiving
+  std::uint32_t _nextExpectedSequenceNumber = 0;
+  std::deque<bool> _receivedAhead; // [i] = message (_nextExpectedSequenceNumber + i) was received
+  std::uint32_t _nextOrderedSequenceNumberToDeliver = 0;
+  std::deque<std::optional<std::vector<unsigned char>>> _heldOrderedMessages;
+  std::deque<std::vector<unsigned char>> _deliveredMessages;
+  std::vector<unsigned char> _currentMessage; // Viewed by the last MessageView handed out
+  Clock::time_point _ackDueTime = Clock::time_point::max();
+
+  std::vector<unsigned char> _datagramBuffer;
+  std::minstd_rand _lossGenerator;
+  std::uniform_real_distribution<double> _lossDistribution{0.0, 1.0};
+
+  Statistics _statistics{};
+  bool _failed = false;
+  std::string _failureMessage;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// RELIABLE CHANNEL                                                      //
+///////////////////////////////////////////////////////////////////////////
+
+ReliableChannel::ReliableChannel(Socket& aSocket, const Endpoint& aRemoteEndpoint)
+  : _impl{std::make_unique<Impl>(aSocket, aRemoteEndpoint, Config{})}
+{
+}
+
+ReliableChannel::ReliableChannel(Socket& aSocket,
+                                 const Endpoint& aRemoteEndpoint,
+                                 const Config& aConfig)
+  : _impl{std::make_unique<Impl>(aSocket, aRemoteEndpoint, aConfig)}
+{
+}
+
+ReliableChannel::~ReliableChannel() = default;
+
+ReliableChannel::ReliableChannel(ReliableChannel&&) = default;
+
+ReliableChannel& ReliableChannel::operator=(ReliableChannel&&) = default;
+
+EmptyResult ReliableChannel::sendMessage(const void* aData,
+                                         std::size_t aDataByteSize,
+                                         MessageOrdering aOrdering) {
+  return _impl->sendMessage(aData, aDataByteSize, aOrdering);
+}
+
+EmptyResult ReliableChannel::update() {
+  return _impl->update();
+}
+
+Result<MessageView> ReliableChannel::receiveMessage() {
+  return _impl->receiveMessage();
+}
+
+bool ReliableChannel::hasReceivedMessage() const {
+  return _impl->hasReceivedMessage();
+}
+
+std::chrono::milliseconds ReliableChannel::getTimeUntilNextUpdate() const {
+  return _impl->getTimeUntilNextUpdate();
+}
+
+std::size_t ReliableChannel::getPendingMessageCount() const {
+  return _impl->getPendingMessageCount();
+}
+
+const Endpoint& ReliableChannel::getRemoteEndpoint() const {
+  return _impl->getRemoteEndpoint();
+}
+
+ReliableChannel::Statistics ReliableChannel::getStatistics() const {
+  return _impl->getStatistics();
+}
+
+ZTCPP_NAMESPACE_END
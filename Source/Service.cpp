@@ -2,18 +2,43 @@
 #include <ZTCpp/Service.hpp>
 #include <ZTCpp/Events.hpp>
 
+#include "Metrics_util.hpp"
+#include "Tracing_util.hpp"
+
+#include <chrono>
 #include <cstdlib>
 
 #include <ZeroTierSockets.h>
 
 ZTCPP_NAMESPACE_BEGIN
 
+namespace {
+
+//! Records how long it was alive in the LocalNode::start() duration metric.
+class NodeStartTimer {
+public:
+  NodeStartTimer()
+    : _startTime{std::chrono::steady_clock::now()}
+  {
+  }
+
+  ~NodeStartTimer() {
+    detail::RecordNodeStartMetric(std::chrono::steady_clock::now() - _startTime);
+  }
+
+private:
+  std::chrono::steady_clock::time_point _startTime;
+};
+
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////
 // CONFIGURATION                                                         //
 ///////////////////////////////////////////////////////////////////////////
 
 EmptyResult Config::setIdentityFromStorage(const std::string& aPath) {
-  const auto res = zts_init_from_storage(aPath.c_str());
+  const auto res = ZTCPP_TRACE_CALL("zts_init_from_storage", -1, 0,
+                                    zts_init_from_storage(aPath.c_str()));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -33,7 +58,8 @@ EmptyResult Config::setIdentityFromStorage(const std::string& aPath) {
 }
 
 EmptyResult Config::setIdentityFromMemory(const char* aKey, std::size_t aKeyLength) {
-  const auto res = zts_init_from_memory(aKey, aKeyLength);
+  const auto res = ZTCPP_TRACE_CALL("zts_init_from_memory", -1, 0,
+                                    zts_init_from_memory(aKey, aKeyLength));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -53,7 +79,7 @@ EmptyResult Config::setIdentityFromMemory(const char* aKey, std::size_t aKeyLeng
 }
 
 EmptyResult Config::setPort(uint16_t aPort) {
-  const auto res = zts_init_set_port(aPort);
+  const auto res = ZTCPP_TRACE_CALL("zts_init_set_port", -1, 0, zts_init_set_port(aPort));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -73,7 +99,8 @@ EmptyResult Config::setPort(uint16_t aPort) {
 }
 
 EmptyResult Config::setRandomPortRange(uint16_t aStartPort, uint16_t aEndPort) {
-  const auto res = zts_init_set_random_port_range(aStartPort, aEndPort);
+  const auto res = ZTCPP_TRACE_CALL("zts_init_set_random_port_range", -1, 0,
+                                    zts_init_set_random_port_range(aStartPort, aEndPort));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -93,7 +120,8 @@ EmptyResult Config::setRandomPortRange(uint16_t aStartPort, uint16_t aEndPort) {
 }
 
 EmptyResult Config::allowSecondaryPort(bool aAllowed) {
-  const auto res = zts_init_allow_secondary_port(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_secondary_port", -1, 0,
+                                    zts_init_allow_secondary_port(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -113,7 +141,8 @@ EmptyResult Config::allowSecondaryPort(bool aAllowed) {
 }
 
 EmptyResult Config::allowPortMapping(bool aAllowed) {
-  const auto res = zts_init_allow_port_mapping(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_port_mapping", -1, 0,
+                                    zts_init_allow_port_mapping(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -133,7 +162,8 @@ EmptyResult Config::allowPortMapping(bool aAllowed) {
 }
 
 EmptyResult Config::allowNetworkCaching(bool aAllowed) {
-  const auto res = zts_init_allow_net_cache(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_net_cache", -1, 0,
+                                    zts_init_allow_net_cache(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -153,7 +183,8 @@ EmptyResult Config::allowNetworkCaching(bool aAllowed) {
 }
 
 EmptyResult Config::allowPeerCaching(bool aAllowed) {
-  const auto res = zts_init_allow_peer_cache(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_peer_cache", -1, 0,
+                                    zts_init_allow_peer_cache(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -173,7 +204,8 @@ EmptyResult Config::allowPeerCaching(bool aAllowed) {
 }
 
 EmptyResult Config::allowRootCaching(bool aAllowed) {
-  const auto res = zts_init_allow_roots_cache(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_roots_cache", -1, 0,
+                                    zts_init_allow_roots_cache(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -193,7 +225,8 @@ EmptyResult Config::allowRootCaching(bool aAllowed) {
 }
 
 EmptyResult Config::allowIdentityCaching(bool aAllowed) {
-  const auto res = zts_init_allow_id_cache(static_cast<unsigned>(aAllowed));
+  const auto res = ZTCPP_TRACE_CALL("zts_init_allow_id_cache", -1, 0,
+                                    zts_init_allow_id_cache(static_cast<unsigned>(aAllowed)));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -226,8 +259,10 @@ EventHandlerInterface* LocalNode::getEventHandler() {
 }
 
 EmptyResult LocalNode::start() {
+  const NodeStartTimer timer;
   {
-    const auto res = zts_init_set_event_handler(&detail::IntermediateEventHandler);
+    const auto res = ZTCPP_TRACE_CALL("zts_init_set_event_handler", -1, 0,
+                                      zts_init_set_event_handler(&detail::IntermediateEventHandler));
 
     if (res == ZTS_ERR_OK) {
       goto START_NODE;
@@ -248,7 +283,7 @@ EmptyResult LocalNode::start() {
   }
 START_NODE:
   {
-    const auto res = zts_node_start();
+    const auto res = ZTCPP_TRACE_CALL("zts_node_start", -1, 0, zts_node_start());
 
     if (res == ZTS_ERR_OK) {
       return EmptyResultOK();
@@ -265,7 +300,7 @@ START_NODE:
 }
 
 EmptyResult LocalNode::stop() {
-  const auto res = zts_node_stop();
+  const auto res = ZTCPP_TRACE_CALL("zts_node_stop", -1, 0, zts_node_stop());
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -281,7 +316,7 @@ EmptyResult LocalNode::stop() {
 }
 
 EmptyResult LocalNode::freeResources() {
-  const auto res = zts_node_free();
+  const auto res = ZTCPP_TRACE_CALL("zts_node_free", -1, 0, zts_node_free());
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -297,15 +332,15 @@ EmptyResult LocalNode::freeResources() {
 }
 
 bool LocalNode::isOnline() {
-  return static_cast<bool>(zts_node_is_online());
+  return static_cast<bool>(ZTCPP_TRACE_CALL("zts_node_is_online", -1, 0, zts_node_is_online()));
 }
 
 uint64_t LocalNode::getID() {
-  return zts_node_get_id();
+  return ZTCPP_TRACE_CALL("zts_node_get_id", -1, 0, zts_node_get_id());
 }
 
 uint16_t LocalNode::getPort() {
-  return zts_node_get_port();
+  return ZTCPP_TRACE_CALL("zts_node_get_port", -1, 0, zts_node_get_port());
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -313,7 +348,7 @@ uint16_t LocalNode::getPort() {
 ///////////////////////////////////////////////////////////////////////////
 
 EmptyResult Network::join(uint64_t aNetworkId) {
-  const auto res = zts_net_join(aNetworkId);
+  const auto res = ZTCPP_TRACE_CALL("zts_net_join", -1, 0, zts_net_join(aNetworkId));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -332,7 +367,7 @@ EmptyResult Network::join(uint64_t aNetworkId) {
 }
 
 EmptyResult Network::leave(uint64_t aNetworkId) {
-  const auto res = zts_net_leave(aNetworkId);
+  const auto res = ZTCPP_TRACE_CALL("zts_net_leave", -1, 0, zts_net_leave(aNetworkId));
 
   if (res == ZTS_ERR_OK) {
     return EmptyResultOK();
@@ -351,17 +386,20 @@ EmptyResult Network::leave(uint64_t aNetworkId) {
 }
 
 bool Network::isTransportReady(uint64_t aNetworkId) {
-  return static_cast<bool>(zts_net_transport_is_ready(aNetworkId));
+  return static_cast<bool>(ZTCPP_TRACE_CALL("zts_net_transport_is_ready", -1, 0,
+                                            zts_net_transport_is_ready(aNetworkId)));
 }
 
 bool Network::isBroadcastEnabled(uint64_t aNetworkId) {
-  return static_cast<bool>(zts_net_get_broadcast(aNetworkId));
+  return static_cast<bool>(ZTCPP_TRACE_CALL("zts_net_get_broadcast", -1, 0,
+                                            zts_net_get_broadcast(aNetworkId)));
 }
 
 Result<std::string> Network::getName(uint64_t aNetworkId) {
   char charbuf[200];
 
-  const auto res = zts_net_get_name(aNetworkId, charbuf, sizeof(charbuf) / sizeof(charbuf[0]));
+  const auto res = ZTCPP_TRACE_CALL("zts_net_get_name", -1, 0,
+                                    zts_net_get_name(aNetworkId, charbuf, sizeof(charbuf) / sizeof(charbuf[0])));
 
   if (res == ZTS_ERR_OK) {
     return std::string{charbuf};
@@ -380,11 +418,11 @@ Result<std::string> Network::getName(uint64_t aNetworkId) {
 }
 
 int Network::getStatus(uint64_t aNetworkId) {
-  return zts_net_get_status(aNetworkId);
+  return ZTCPP_TRACE_CALL("zts_net_get_status", -1, 0, zts_net_get_status(aNetworkId));
 }
 
 int Network::getType(uint64_t aNetworkId) {
-  return zts_net_get_type(aNetworkId);
+  return ZTCPP_TRACE_CALL("zts_net_get_type", -1, 0, zts_net_get_type(aNetworkId));
 }
 
 ZTCPP_NAMESPACE_END
\ No newline at end of file
@@ -83,5 +83,13 @@ void ToIpAddressAndPort(const struct zts_sockaddr_storage* aSockaddr,
   }
 }
 
+std::uint32_t GetSockaddrLength(const struct zts_sockaddr_storage* aSockaddr) {
+  switch (aSockaddr->ss_family) {
+  case ZTS_AF_INET:  return sizeof(struct zts_sockaddr_in);
+  case ZTS_AF_INET6: return sizeof(struct zts_sockaddr_in6);
+  default:           return 0;
+  }
+}
+
 } // namespace detail
 ZTCPP_NAMESPACE_END
\ No newline at end of file
@@ -2,11 +2,13 @@
 #define ZTCPP_SOCKADDR_UTIL_HPP
 
 #include <ZTCpp/Definitions.hpp>
+#include <ZTCpp/Endpoint.hpp>
 #include <ZTCpp/Ip_address.hpp>
 
 #include <cstring>
 
 extern "C" {
+struct zts_sockaddr;
 struct zts_sockaddr_storage;
 } // extern "C"
 
@@ -24,6 +26,25 @@ void ToIpAddressAndPort(const struct zts_sockaddr_storage* aSockaddr,
                         IpAddress& aIpAddress, 
                         std::uint16_t& aPortInHostOrder);
 
+//! Returns the actual size of the zts_sockaddr_in or zts_sockaddr_in6 held by
+//! aSockaddr (which is what libzt expects to be passed as the address length),
+//! or 0 if the address family is unknown.
+//! Don't pass a null pointer!
+std::uint32_t GetSockaddrLength(const struct zts_sockaddr_storage* aSockaddr);
+
+//! Gives access to the sockaddr which is cached inside an Endpoint.
+struct EndpointAccess {
+  //! Only meaningful if aEndpoint is valid.
+  static const struct zts_sockaddr* getSockaddr(const Endpoint& aEndpoint);
+
+  //! Returns 0 if aEndpoint is invalid.
+  static std::uint32_t getSockaddrLength(const Endpoint& aEndpoint);
+
+  //! Sets aEndpoint from a sockaddr filled out by libzt. If the address family
+  //! is unknown, aEndpoint becomes invalid.
+  static void setFromSockaddr(Endpoint& aEndpoint, const struct zts_sockaddr_storage* aSockaddr);
+};
+
 } // namespace detail
 ZTCPP_NAMESPACE_END
 
@@ -1,12 +1,128 @@
 
 #include <ZTCpp/Socket.hpp>
 
+#include "Metrics_util.hpp"
+#include "Poll_util.hpp"
 #include "Sockaddr_util.hpp"
+#include "Tracing_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <vector>
 
 #include <ZeroTierSockets.h>
 
 ZTCPP_NAMESPACE_BEGIN
 
+namespace {
+
+//! Number of buffer segments that sendv()/receivev() can convert into zts_iovec
+//! structures without resorting to a heap allocation.
+constexpr std::size_t INLINE_IOVEC_COUNT = 16;
+
+//! Holds a zts_iovec array corresponding to a list of buffer segments.
+class IovecArray {
+public:
+  template <class taSegment>
+  IovecArray(const taSegment* aSegments, std::size_t aSegmentCount)
+    : _count{aSegmentCount}
+  {
+    struct zts_iovec* iovecs = _inlineIovecs;
+    if (aSegmentCount > INLINE_IOVEC_COUNT) {
+      _overflowIovecs.resize(aSegmentCount);
+      iovecs = _overflowIovecs.data();
+    }
+    for (std::size_t i = 0; i < aSegmentCount; i += 1) {
+      iovecs[i].iov_base = const_cast<void*>(static_cast<const void*>(aSegments[i].data));
+      iovecs[i].iov_len  = aSegments[i].byteSize;
+    }
+  }
+
+  const struct zts_iovec* get() const {
+    return (_count > INLINE_IOVEC_COUNT) ? _overflowIovecs.data() : _inlineIovecs;
+  }
+
+  int getCount() const {
+    return static_cast<int>(_count);
+  }
+
+private:
+  struct zts_iovec _inlineIovecs[INLINE_IOVEC_COUNT];
+  std::vector<struct zts_iovec> _overflowIovecs;
+  std::size_t _count;
+};
+
+template <class taSegment>
+bool SegmentsAreValid(const taSegment* aSegments, std::size_t aSegmentCount) {
+  if (aSegments == nullptr || aSegmentCount == 0 ||
+      aSegmentCount > static_cast<std::size_t>(INT_MAX)) {
+    return false;
+  }
+  for (std::size_t i = 0; i < aSegmentCount; i += 1) {
+    if (aSegments[i].data == nullptr && aSegments[i].byteSize != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#ifdef ZTS_MSG_TRUNC
+constexpr int ZT_MSG_TRUNC = ZTS_MSG_TRUNC;
+#else
+//! Not every version of ZeroTierSockets.h exports MSG_TRUNC, but lwIP reports
+//! truncated datagrams in msghdr::msg_flags using this value.
+constexpr int ZT_MSG_TRUNC = 0x04;
+#endif
+
+template <class taSegment>
+std::size_t GetTotalByteSize(const taSegment* aSegments, std::size_t aSegmentCount) {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < aSegmentCount; i += 1) {
+    result += aSegments[i].byteSize;
+  }
+  return result;
+}
+
+//! True if neither the address nor the port of aEndpoint is left for libzt to
+//! choose, meaning that the socket's actual endpoint can't change anymore.
+bool IsFullySpecified(const Endpoint& aEndpoint) {
+  return (aEndpoint.getPort() != 0 &&
+          aEndpoint.getIpAddress() != IpAddress::ipv4Unspecified() &&
+          aEndpoint.getIpAddress() != IpAddress::ipv6Unspecified());
+}
+
+//! Counter behind Socket::getStatistics(). Only relaxed operations are used: the
+//! counters don't synchronize anything, they just need to be readable from other
+//! threads without tearing.
+using StatisticsCounter = std::atomic<uint64_t>;
+
+void AddToCounter(StatisticsCounter& aCounter, uint64_t aValue) {
+  aCounter.fetch_add(aValue, std::memory_order_relaxed);
+}
+
+//! Converts a combination of IoFlags::Enum values to ZTS_MSG_* flags.
+int ToZTMessageFlags(int aFlags) {
+  int result = 0;
+  if ((aFlags & IoFlags::Peek) != 0) {
+    result |= ZTS_MSG_PEEK;
+  }
+  if ((aFlags & IoFlags::DontWait) != 0) {
+    result |= ZTS_MSG_DONTWAIT;
+  }
+  if ((aFlags & IoFlags::WaitAll) != 0) {
+    result |= ZTS_MSG_WAITALL;
+  }
+  if ((aFlags & IoFlags::More) != 0) {
+    result |= ZTS_MSG_MORE;
+  }
+  return result;
+}
+
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////
 // SOCKET IMPL                                                           //
 ///////////////////////////////////////////////////////////////////////////
@@ -15,6 +131,36 @@ class Socket::Impl {
 public:
   Impl() = default;
 
+  Impl(Impl&& aOther) noexcept
+    : _socketDomain{aOther._socketDomain}
+    , _socketType{aOther._socketType}
+    , _socketID{aOther._socketID}
+    , _localEndpoint{aOther._localEndpoint}
+    , _remoteEndpoint{aOther._remoteEndpoint}
+  {
+    aOther._socketID = ZTS_ERR_SOCKET;
+    aOther.forgetEndpoints();
+    _statistics.copyFrom(aOther._statistics);
+  }
+
+  Impl& operator=(Impl&& aOther) noexcept {
+    if (this != &aOther) {
+      (void)close();
+      _socketDomain = aOther._socketDomain;
+      _socketType = aOther._socketType;
+      _socketID = aOther._socketID;
+      _localEndpoint = aOther._localEndpoint;
+      _remoteEndpoint = aOther._remoteEndpoint;
+      aOther._socketID = ZTS_ERR_SOCKET;
+      aOther.forgetEndpoints();
+      _statistics.copyFrom(aOther._statistics);
+    }
+    return *this;
+  }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+
   ~Impl() {
     close();
   }
@@ -33,9 +179,12 @@ public:
                                  "aSocketType has invalid value")};
     }
 
+    forgetEndpoints();
+    _statistics.reset();
     _socketDomain = aSocketDomain;
     _socketType = aSocketType;
-    _socketID = zts_socket(getZTAddressFamily(), getZTSocketType(), getZTProtocolFamily());
+    _socketID = ZTCPP_TRACE_CALL("zts_socket", -1, 0,
+                                 zts_socket(getZTAddressFamily(), getZTSocketType(), getZTProtocolFamily()));
 
     if (_socketID == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
@@ -46,6 +195,7 @@ public:
                                  "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
 
+    detail::RecordSocketOpenedMetric();
     return EmptyResultOK();
   }
 
@@ -59,12 +209,16 @@ public:
                                  "aLocalIpAddress is of wrong address family")};
     }
 
-    const auto sockaddr = detail::ToSockaddr(aLocalIpAddress, aLocalPortInHostOrder);
-    const auto res = zts_bsd_bind(_socketID,
-                                  reinterpret_cast<const struct zts_sockaddr*>(&sockaddr),
-                                  sizeof(sockaddr));
+    const Endpoint localEndpoint{aLocalIpAddress, aLocalPortInHostOrder};
+    const auto res = ZTCPP_TRACE_CALL("zts_bsd_bind", _socketID, 0,
+                                      zts_bsd_bind(_socketID,
+                                                   detail::EndpointAccess::getSockaddr(localEndpoint),
+                                                   detail::EndpointAccess::getSockaddrLength(localEndpoint)));
 
     if (res == ZTS_ERR_OK) {
+      // If the address or the port was left for libzt to choose, the actual
+      // endpoint will be looked up when it's asked for
+      _localEndpoint = IsFullySpecified(localEndpoint) ? localEndpoint : Endpoint{};
       return EmptyResultOK();
     }
 
@@ -101,15 +255,29 @@ public:
                                      "aRemoteIpAddress is of wrong address family")};
       }
 
-      const auto sockaddr = detail::ToSockaddr(aRemoteIpAddress, aRemotePortInHostOrder);
-      const auto res = zts_bsd_connect(_socketID,
-                                       reinterpret_cast<const struct zts_sockaddr*>(&sockaddr),
-                                       sizeof(sockaddr));
+      const Endpoint remoteEndpoint{aRemoteIpAddress, aRemotePortInHostOrder};
+      const auto res = callMaybeBlocking(true, [&]() {
+        return ZTCPP_TRACE_CALL("zts_bsd_connect", _socketID, 0,
+                                zts_bsd_connect(_socketID,
+                                                detail::EndpointAccess::getSockaddr(remoteEndpoint),
+                                                detail::EndpointAccess::getSockaddrLength(remoteEndpoint)));
+      });
+
+      // Connecting implicitly binds the socket if it wasn't bound already
+      _localEndpoint = Endpoint{};
 
       if (res == ZTS_ERR_OK) {
+          _remoteEndpoint = remoteEndpoint;
           return EmptyResultOK();
       }
 
+      // A non-blocking connect reports EINPROGRESS and completes in the background
+      if (res == ZTS_ERR_SOCKET && (lastCallWouldBlock() || zts_errno == ZTS_EINPROGRESS)) {
+          AddToCounter(_statistics.wouldBlockCount, 1);
+          detail::RecordErrorMetric(ErrorCode::WouldBlock);
+          return ResultWouldBlock();
+      }
+      recordFailure(res);
       if (res == ZTS_ERR_SOCKET) {
           return {ZTCPP_ERROR_REPORT(SocketError,
                                      "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
@@ -128,8 +296,56 @@ public:
                                  ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
+  EmptyResult connect(const IpAddress& aRemoteIpAddress,
+                      uint16_t aRemotePortInHostOrder,
+                      Deadline aDeadline) {
+    if (aDeadline == NO_DEADLINE) {
+      return connect(aRemoteIpAddress, aRemotePortInHostOrder);
+    }
+
+    // Connect in non-blocking mode, then wait (for no longer than the deadline
+    // allows) for the connection to complete
+    auto wasNonBlocking = getNonBlocking();
+    if (!wasNonBlocking) {
+      return {std::make_unique<ErrorReport>(std::move(wasNonBlocking.getError()))};
+    }
+    if (!*wasNonBlocking) {
+      auto res = setNonBlocking(true);
+      if (!res) {
+        return res;
+      }
+    }
+
+    auto res = connect(aRemoteIpAddress, aRemotePortInHostOrder);
+    if (res.wouldBlock()) {
+      res = finishConnect(aDeadline);
+      if (res) {
+        _remoteEndpoint = Endpoint{aRemoteIpAddress, aRemotePortInHostOrder};
+      }
+    }
+
+    if (!*wasNonBlocking) {
+      (void)setNonBlocking(false);
+    }
+    return res;
+  }
+
+  //! Checks SO_ERROR to see if a non-blocking connect() succeeded.
+  EmptyResult finishConnect() {
+    auto error = getIntOption(ZTS_SOL_SOCKET, ZTS_SO_ERROR);
+    if (!error) {
+      return {std::make_unique<ErrorReport>(std::move(error.getError()))};
+    }
+    if (*error != 0) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "Connection failed (SO_ERROR=" + std::to_string(*error) + ")")};
+    }
+    return EmptyResultOK();
+  }
+
   EmptyResult listen(std::size_t aMaxQueueSize) {
-      const auto res = zts_bsd_listen(_socketID, aMaxQueueSize);
+      const auto res = ZTCPP_TRACE_CALL("zts_bsd_listen", _socketID, 0,
+                                        zts_bsd_listen(_socketID, aMaxQueueSize));
 
       if (res == ZTS_ERR_OK) {
           return EmptyResultOK();
@@ -153,11 +369,33 @@ public:
                                  ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  Result<Socket> accept() {
-      char buffer[ZTS_IP_MAX_STR_LEN];
-      unsigned short port;
-      const auto res = zts_accept(_socketID, buffer, ZTS_IP_MAX_STR_LEN, &port);
-
+  Result<Socket> accept(IpAddress* aRemoteIpAddress, uint16_t* aRemotePort) {
+      struct zts_sockaddr_storage peerSockaddr;
+      zts_socklen_t peerSockaddrLen = sizeof(peerSockaddr);
+      const auto res = callMaybeBlocking(true, [&]() {
+        return ZTCPP_TRACE_CALL("zts_bsd_accept", _socketID, 0,
+                                zts_bsd_accept(_socketID,
+                                               reinterpret_cast<struct zts_sockaddr*>(&peerSockaddr),
+                                               &peerSockaddrLen));
+      });
+
+      if (res >= 0) {
+          AddToCounter(_statistics.connectionsAccepted, 1);
+          detail::RecordSocketOpenedMetric();
+          if (aRemoteIpAddress != nullptr && aRemotePort != nullptr) {
+              detail::ToIpAddressAndPort(&peerSockaddr, *aRemoteIpAddress, *aRemotePort);
+          }
+          Impl impl;
+          impl._socketDomain = _socketDomain;
+          impl._socketType = _socketType;
+          impl._socketID = res;
+          detail::EndpointAccess::setFromSockaddr(impl._remoteEndpoint, &peerSockaddr);
+          return {Socket{std::move(impl)}};
+      }
+      recordFailure(res);
+      if (res == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+          return ResultWouldBlock();
+      }
       if (res == ZTS_ERR_SOCKET) {
           return {ZTCPP_ERROR_REPORT(SocketError,
                                      "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
@@ -171,26 +409,125 @@ public:
                                      "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
       }
 
-      Socket socket;
-      std::unique_ptr<Impl>* socketImpl = (std::unique_ptr<Impl>*) &socket;
-      *socketImpl = std::make_unique<Impl>();
-      **socketImpl = *this;
-      (*socketImpl)->_socketID = res;
+      return {ZTCPP_ERROR_REPORT(GenericError,
+                                 "Unknown error (zts_bsd_accept returned " + std::to_string(res) +
+                                 ", zts_errno= " + std::to_string(zts_errno) + ")")};
+  }
+
+  Result<std::size_t> acceptMany(std::vector<AcceptedConnection>& aConnections,
+                                 std::size_t aMaxCount) {
+    if (aMaxCount == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aMaxCount == 0")};
+    }
+
+    // A non-blocking listener is simply drained until accept() would block;
+    // only a blocking one needs a poll before each accept after the first
+    // (if the mode can't be determined, assume blocking)
+    const auto nonBlocking = getNonBlocking();
+    const bool mustPoll = !nonBlocking || !*nonBlocking;
+
+    std::size_t acceptedCount = 0;
+    for (; acceptedCount < aMaxCount; acceptedCount += 1) {
+      // Only the first call is allowed to block
+      if (acceptedCount > 0 && mustPoll && !hasPendingConnection()) {
+        break;
+      }
+      IpAddress remoteIpAddress;
+      uint16_t remotePort = 0;
+      auto res = accept(&remoteIpAddress, &remotePort);
+      if (!res) {
+        if (acceptedCount > 0) {
+          break; // Nothing left, or the error will be reported by the next call
+        }
+        if (res.wouldBlock()) {
+          return ResultWouldBlock();
+        }
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      aConnections.push_back(AcceptedConnection{std::move(*res), remoteIpAddress, remotePort});
+    }
+
+    return {acceptedCount};
+  }
+
+  Result<Socket> accept(Deadline aDeadline) {
+    if (aDeadline == NO_DEADLINE) {
+      return accept(nullptr, nullptr);
+    }
+
+    while (true) {
+      // Wait first - if the socket is blocking, zts_accept() would block
+      auto waitRes = waitUntilReady(ZTS_POLLIN, aDeadline);
+      if (!waitRes) {
+        return {std::make_unique<ErrorReport>(std::move(waitRes.getError()))};
+      }
+      auto res = accept(nullptr, nullptr);
+      if (!res.wouldBlock()) {
+        return res;
+      }
+    }
+  }
+
+  Result<std::size_t> send(const void* aData,
+                           std::size_t aDataByteSize,
+                           Deadline aDeadline) {
+    if (aDeadline == NO_DEADLINE) {
+      return send(aData, aDataByteSize, IoFlags::None);
+    }
+
+    while (true) {
+      auto res = send(aData, aDataByteSize, IoFlags::DontWait);
+      if (!res.wouldBlock()) {
+        return res;
+      }
+      auto waitRes = waitUntilReady(ZTS_POLLOUT, aDeadline);
+      if (!waitRes) {
+        return {std::make_unique<ErrorReport>(std::move(waitRes.getError()))};
+      }
+    }
+  }
+
+  Result<std::size_t> receive(void* aDestinationBuffer,
+                              std::size_t aDestinationBufferByteSize,
+                              Deadline aDeadline) {
+    if (aDeadline == NO_DEADLINE) {
+      return receive(aDestinationBuffer, aDestinationBufferByteSize, IoFlags::None, nullptr);
+    }
 
-      return {std::move(socket)};
+    while (true) {
+      auto res = receive(aDestinationBuffer, aDestinationBufferByteSize, IoFlags::DontWait, nullptr);
+      if (!res.wouldBlock()) {
+        return res;
+      }
+      auto waitRes = waitUntilReady(ZTS_POLLIN, aDeadline);
+      if (!waitRes) {
+        return {std::make_unique<ErrorReport>(std::move(waitRes.getError()))};
+      }
+    }
   }
 
   Result<std::size_t> send(const void* aData,
-                           std::size_t aDataByteSize) {
+                           std::size_t aDataByteSize,
+                           int aFlags) {
       if (aData == nullptr || aDataByteSize == 0) {
           return {ZTCPP_ERROR_REPORT(ArgumentError,
                                      "aData is null or aDataByteSize == 0")};
       }
 
-      const auto byteCount = zts_send(_socketID, aData, aDataByteSize, 0);
+      const int ztFlags = ToZTMessageFlags(aFlags);
+      const auto byteCount = callMaybeBlocking((ztFlags & ZTS_MSG_DONTWAIT) == 0, [&]() {
+        return ZTCPP_TRACE_CALL("zts_send", _socketID, aDataByteSize,
+                                zts_send(_socketID, aData, aDataByteSize, ztFlags));
+      });
+      recordSend(byteCount, aDataByteSize);
 
-      if (byteCount == static_cast<decltype(byteCount)>(aDataByteSize)) {
-          return {aDataByteSize};
+      // A partial write is normal for stream sockets (see sendAll())
+      if (byteCount >= 0) {
+          return {static_cast<std::size_t>(byteCount)};
+      }
+      if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+          return ResultWouldBlock();
       }
       if (byteCount == ZTS_ERR_SOCKET) {
           return {ZTCPP_ERROR_REPORT(SocketError,
@@ -210,32 +547,110 @@ public:
                                  ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
+  Result<std::size_t> sendAll(const void* aData,
+                              std::size_t aDataByteSize,
+                              Deadline aDeadline,
+                              std::size_t* aBytesSent) {
+    std::size_t bytesSent = 0;
+    auto res = transferAll(aData, aDataByteSize, aDeadline, bytesSent, true);
+    if (aBytesSent) {
+      *aBytesSent = bytesSent;
+    }
+    return res;
+  }
+
+  Result<std::size_t> receiveExact(void* aDestinationBuffer,
+                                   std::size_t aByteCount,
+                                   Deadline aDeadline,
+                                   std::size_t* aBytesReceived) {
+    std::size_t bytesReceived = 0;
+    auto res = transferAll(aDestinationBuffer, aByteCount, aDeadline, bytesReceived, false);
+    if (aBytesReceived) {
+      *aBytesReceived = bytesReceived;
+    }
+    return res;
+  }
+
+  Result<std::size_t> sendv(const ConstBufferSegment* aSegments,
+                            std::size_t aSegmentCount) {
+    if (!SegmentsAreValid(aSegments, aSegmentCount)) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aSegments is null, empty or contains a null segment")};
+    }
+
+    const IovecArray iovecs{aSegments, aSegmentCount};
+    const auto byteCount = callMaybeBlocking(true, [&]() {
+      return ZTCPP_TRACE_CALL("zts_bsd_writev", _socketID, GetTotalByteSize(aSegments, aSegmentCount),
+                              zts_bsd_writev(_socketID, iovecs.get(), iovecs.getCount()));
+    });
+    recordSend(byteCount, GetTotalByteSize(aSegments, aSegmentCount));
+
+    if (byteCount >= 0) {
+      return {static_cast<std::size_t>(byteCount)};
+    }
+    if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
+    }
+    if (byteCount == ZTS_ERR_SOCKET) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (byteCount == ZTS_ERR_SERVICE) {
+      return {ZTCPP_ERROR_REPORT(ServiceError,
+                                 "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (byteCount == ZTS_ERR_ARG) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+
+    return {ZTCPP_ERROR_REPORT(GenericError,
+                               "Unknown error (zts_bsd_writev returned " + std::to_string(byteCount) +
+                               ", zts_errno= " + std::to_string(zts_errno) + ")")};
+  }
+
   Result<std::size_t> sendTo(const void* aData,
                              std::size_t aDataByteSize,
                              const IpAddress& aRemoteIpAddress,
                              uint16_t aLocalPortInHostOrder) {
+    if (!aRemoteIpAddress.isValid()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aRemoteIpAddress is invalid")};
+    }
+    return sendTo(aData, aDataByteSize, Endpoint{aRemoteIpAddress, aLocalPortInHostOrder});
+  }
+
+  Result<std::size_t> sendTo(const void* aData,
+                             std::size_t aDataByteSize,
+                             const Endpoint& aRemoteEndpoint) {
     if (aData == nullptr || aDataByteSize == 0) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
                                  "aData is null or aDataByteSize == 0")};
     }
-    if (!aRemoteIpAddress.isValid()) {
+    if (!aRemoteEndpoint.isValid()) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
-                                 "aRemoteIpAddress is invalid")};
+                                 "aRemoteEndpoint is invalid")};
     }
-    if (aRemoteIpAddress.getAddressFamily() != getAddressFamily()) {
+    if (aRemoteEndpoint.getIpAddress().getAddressFamily() != getAddressFamily()) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
-                                 "aRemoteIpAddress is of wrong address family")};
+                                 "aRemoteEndpoint is of wrong address family")};
     }
 
-    const auto sockaddr = detail::ToSockaddr(aRemoteIpAddress, aLocalPortInHostOrder);
-    const auto byteCount = zts_bsd_sendto(_socketID,
-                                          aData, aDataByteSize,
-                                          0,
-                                          reinterpret_cast<const struct zts_sockaddr*>(&sockaddr),
-                                          sizeof(sockaddr));
-
-    if (byteCount == static_cast<decltype(byteCount)>(aDataByteSize)) {
-      return {aDataByteSize};
+    const auto byteCount = callMaybeBlocking(true, [&]() {
+      return ZTCPP_TRACE_CALL("zts_bsd_sendto", _socketID, aDataByteSize,
+                              zts_bsd_sendto(_socketID,
+                                             aData, aDataByteSize,
+                                             0,
+                                             detail::EndpointAccess::getSockaddr(aRemoteEndpoint),
+                                             detail::EndpointAccess::getSockaddrLength(aRemoteEndpoint)));
+    });
+    recordSend(byteCount, aDataByteSize);
+
+    if (byteCount >= 0) {
+      return {static_cast<std::size_t>(byteCount)};
+    }
+    if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
     }
     if (byteCount == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
@@ -255,21 +670,90 @@ public:
                                ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
+  Result<std::size_t> sendToMany(OutgoingDatagram* aDatagrams,
+                                 std::size_t aDatagramCount) {
+    if (aDatagrams == nullptr || aDatagramCount == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aDatagrams is null or aDatagramCount == 0")};
+    }
+    for (std::size_t i = 0; i < aDatagramCount; i += 1) {
+      const auto& datagram = aDatagrams[i];
+      if (datagram.data == nullptr || datagram.dataByteSize == 0) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "datagram #" + std::to_string(i) +
+                                   " has null data or dataByteSize == 0")};
+      }
+      if (!datagram.remoteIpAddress.isValid() ||
+          datagram.remoteIpAddress.getAddressFamily() != getAddressFamily()) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "datagram #" + std::to_string(i) +
+                                   " has an invalid remote address or one of wrong address family")};
+      }
+    }
+
+    std::size_t sentCount = 0;
+    ssize_t lastByteCount = 0;
+    for (; sentCount < aDatagramCount; sentCount += 1) {
+      auto& datagram = aDatagrams[sentCount];
+      const auto sockaddr = detail::ToSockaddr(datagram.remoteIpAddress, datagram.remotePort);
+      lastByteCount = callMaybeBlocking(true, [&]() {
+        return ZTCPP_TRACE_CALL("zts_bsd_sendto", _socketID, datagram.dataByteSize,
+                                zts_bsd_sendto(_socketID,
+                                               datagram.data, datagram.dataByteSize,
+                                               0,
+                                               reinterpret_cast<const struct zts_sockaddr*>(&sockaddr),
+                                               detail::GetSockaddrLength(&sockaddr)));
+      });
+      recordSend(lastByteCount, datagram.dataByteSize);
+      if (lastByteCount < 0) {
+        break;
+      }
+      datagram.bytesSent = static_cast<std::size_t>(lastByteCount);
+    }
+
+    if (sentCount > 0) {
+      return {sentCount};
+    }
+    if (lastByteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
+    }
+    if (lastByteCount == ZTS_ERR_SOCKET) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (lastByteCount == ZTS_ERR_SERVICE) {
+      return {ZTCPP_ERROR_REPORT(ServiceError,
+                                 "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (lastByteCount == ZTS_ERR_ARG) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+
+    return {ZTCPP_ERROR_REPORT(GenericError,
+                               "Unknown error (zts_bsd_sendto returned " + std::to_string(lastByteCount) +
+                               ", zts_errno= " + std::to_string(zts_errno) + ")")};
+  }
+
   Result<std::size_t> receive(void* aDestinationBuffer,
-                              std::size_t aDestinationBufferByteSize) {
+                              std::size_t aDestinationBufferByteSize,
+                              int aFlags,
+                              bool* aTruncated) {
       if (aDestinationBuffer == nullptr || aDestinationBufferByteSize == 0) {
           return {ZTCPP_ERROR_REPORT(ArgumentError,
                                      "aDestinationBuffer is null or aDestinationBufferByteSize == 0")};
       }
 
-      struct zts_sockaddr_storage senderSockaddr;
-      zts_socklen_t senderSockaddrLen = sizeof(senderSockaddr);
-
-      const auto byteCount = zts_recv(_socketID, aDestinationBuffer, aDestinationBufferByteSize, 0);
+      const auto byteCount = receiveRaw(aDestinationBuffer, aDestinationBufferByteSize,
+                                        ToZTMessageFlags(aFlags), nullptr, nullptr, aTruncated);
 
-      if (byteCount > 0) {
+      // 0 = orderly shutdown by the remote (Stream) or an empty datagram
+      if (byteCount >= 0) {
           return {static_cast<std::size_t>(byteCount)};
       }
+      if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+          return ResultWouldBlock();
+      }
       if (byteCount == ZTS_ERR_SOCKET) {
           return {ZTCPP_ERROR_REPORT(SocketError,
                                      "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
@@ -284,34 +768,30 @@ public:
       }
 
       return {ZTCPP_ERROR_REPORT(GenericError,
-                                 "Unknown error (zts_recvfrom returned " + std::to_string(byteCount) +
+                                 "Unknown error (zts_recv returned " + std::to_string(byteCount) +
                                  ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
-                                  std::size_t aDestinationBufferByteSize,
-                                  IpAddress& aSenderAddress,
-                                  uint16_t& aSenderPort) {
-    if (aDestinationBuffer == nullptr || aDestinationBufferByteSize == 0) {
+  Result<std::size_t> receivev(const BufferSegment* aSegments,
+                               std::size_t aSegmentCount) {
+    if (!SegmentsAreValid(aSegments, aSegmentCount)) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
-                                 "aDestinationBuffer is null or aDestinationBufferByteSize == 0")};
+                                 "aSegments is null, empty or contains a null segment")};
     }
 
-    struct zts_sockaddr_storage senderSockaddr;
-    zts_socklen_t senderSockaddrLen = sizeof(senderSockaddr);
-
-    const auto byteCount = zts_bsd_recvfrom(_socketID,
-                                            aDestinationBuffer, aDestinationBufferByteSize,
-                                            0, 
-                                            reinterpret_cast<struct zts_sockaddr*>(&senderSockaddr), 
-                                            &senderSockaddrLen);
-
-    detail::ToIpAddressAndPort(reinterpret_cast<struct zts_sockaddr_storage*>(&senderSockaddr),
-                               aSenderAddress, aSenderPort);
+    const IovecArray iovecs{aSegments, aSegmentCount};
+    const auto byteCount = callMaybeBlocking(true, [&]() {
+      return ZTCPP_TRACE_CALL("zts_bsd_readv", _socketID, GetTotalByteSize(aSegments, aSegmentCount),
+                              zts_bsd_readv(_socketID, iovecs.get(), iovecs.getCount()));
+    });
+    recordReceive(byteCount, true);
 
-    if (byteCount > 0) {
+    if (byteCount >= 0) {
       return {static_cast<std::size_t>(byteCount)};
     }
+    if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
+    }
     if (byteCount == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
                                  "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
@@ -326,128 +806,157 @@ public:
     }
 
     return {ZTCPP_ERROR_REPORT(GenericError,
-                               "Unknown error (zts_recvfrom returned " + std::to_string(byteCount) +
+                               "Unknown error (zts_bsd_readv returned " + std::to_string(byteCount) +
                                ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  bool isOpen() const {
-    return (_socketID >= 0);
+  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
+                                  std::size_t aDestinationBufferByteSize,
+                                  IpAddress& aSenderAddress,
+                                  uint16_t& aSenderPort,
+                                  int aFlags,
+                                  bool* aTruncated) {
+    struct zts_sockaddr_storage senderSockaddr;
+    auto res = receiveFrom(aDestinationBuffer, aDestinationBufferByteSize,
+                           senderSockaddr, aFlags, aTruncated);
+    if (res) {
+      detail::ToIpAddressAndPort(&senderSockaddr, aSenderAddress, aSenderPort);
+    }
+    return res;
   }
 
-  EmptyResult close() {
-    if (isOpen()) {
-      const auto res = zts_close(_socketID);
-      _socketID = ZTS_ERR_SOCKET;
-
-      if (res == ZTS_ERR_SOCKET) {
-        return {ZTCPP_ERROR_REPORT(SocketError,
-                                   "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
-      }
-      if (res == ZTS_ERR_SERVICE) {
-        return {ZTCPP_ERROR_REPORT(ServiceError,
-                                   "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
-      }
+  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
+                                  std::size_t aDestinationBufferByteSize,
+                                  Endpoint& aSenderEndpoint,
+                                  int aFlags,
+                                  bool* aTruncated) {
+    struct zts_sockaddr_storage senderSockaddr;
+    auto res = receiveFrom(aDestinationBuffer, aDestinationBufferByteSize,
+                           senderSockaddr, aFlags, aTruncated);
+    if (res) {
+      detail::EndpointAccess::setFromSockaddr(aSenderEndpoint, &senderSockaddr);
     }
-
-    return EmptyResultOK();
+    return res;
   }
 
-  Result<int> pollEvents(PollEventBitmask::Enum aInterestedIn,
-                         std::chrono::milliseconds aMaxTimeToWait) const {
-    if (aInterestedIn == 0) {
+  Result<std::size_t> receiveFrom(void* aDestinationBuffer,
+                                  std::size_t aDestinationBufferByteSize,
+                                  struct zts_sockaddr_storage& aSenderSockaddr,
+                                  int aFlags,
+                                  bool* aTruncated) {
+    if (aDestinationBuffer == nullptr || aDestinationBufferByteSize == 0) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
-                                 "aInterestedIn was 0")};
+                                 "aDestinationBuffer is null or aDestinationBufferByteSize == 0")};
     }
 
-		struct zts_pollfd pollfd;
-    pollfd.fd = _socketID;
-    pollfd.events = 0;
-    pollfd.events |= ((aInterestedIn & PollEventBitmask::ReadyToReceive) != 0)             ? ZTS_POLLIN  : 0;
-    pollfd.events |= ((aInterestedIn & PollEventBitmask::ReadyToSend) != 0)                ? ZTS_POLLOUT : 0;
-    pollfd.events |= ((aInterestedIn & PollEventBitmask::ReadyToReceivePriorityData) != 0) ? ZTS_POLLPRI : 0;
+    zts_socklen_t senderSockaddrLen = sizeof(aSenderSockaddr);
 
-    const int pollres = zts_bsd_poll(&pollfd, 1, static_cast<int>(aMaxTimeToWait.count()));
+    const auto byteCount = receiveRaw(aDestinationBuffer, aDestinationBufferByteSize,
+                                      ToZTMessageFlags(aFlags),
+                                      &aSenderSockaddr, &senderSockaddrLen,
+                                      aTruncated);
 
-    if (pollres == ZTS_ERR_SOCKET) {
+    if (byteCount >= 0) {
+      return {static_cast<std::size_t>(byteCount)};
+    }
+    if (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
+    }
+    if (byteCount == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
                                  "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (pollres == ZTS_ERR_SERVICE) {
+    if (byteCount == ZTS_ERR_SERVICE) {
       return {ZTCPP_ERROR_REPORT(ServiceError,
                                  "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (pollres != 1 && pollres != 0) {
-      return {ZTCPP_ERROR_REPORT(GenericError,
-                                 "Unspecified error from zts_poll (zts_errno=" + std::to_string(zts_errno) + ")")};
-    }
-    if (pollfd.revents & ZTS_POLLNVAL) {
-      return {ZTCPP_ERROR_REPORT(SocketError,
-                                 "zts_poll returned ZTS_POLLNVAL (something wrong with socket descriptor)")};
+    if (byteCount == ZTS_ERR_ARG) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (pollfd.revents & ZTS_POLLHUP) {
-      return {ZTCPP_ERROR_REPORT(SocketError,
-                                 "zts_poll returned ZTS_POLLHUP (remote side of the connection hung up)")};
+
+    return {ZTCPP_ERROR_REPORT(GenericError,
+                               "Unknown error (zts_recvfrom returned " + std::to_string(byteCount) +
+                               ", zts_errno= " + std::to_string(zts_errno) + ")")};
+  }
+
+  Result<std::size_t> receiveFromMany(IncomingDatagram* aDatagrams,
+                                      std::size_t aDatagramCount) {
+    if (aDatagrams == nullptr || aDatagramCount == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aDatagrams is null or aDatagramCount == 0")};
     }
-    if (pollfd.revents & ZTS_POLLERR) {
-      return {ZTCPP_ERROR_REPORT(SocketError,
-                                 "zts_poll returned ZTS_POLLERR")};
+    for (std::size_t i = 0; i < aDatagramCount; i += 1) {
+      if (aDatagrams[i].buffer == nullptr || aDatagrams[i].bufferByteSize == 0) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "datagram #" + std::to_string(i) +
+                                   " has a null buffer or bufferByteSize == 0")};
+      }
     }
 
-    int result = 0;
-    // If zts_poll returned 0, it means the socket wasn't 
-    // ready for any of the events we were interested in
-    if (pollres != 0) {
-      if (pollfd.revents & ZTS_POLLIN)  result |= PollEventBitmask::ReadyToReceive;
-      if (pollfd.revents & ZTS_POLLOUT) result |= PollEventBitmask::ReadyToSend;
-      if (pollfd.revents & ZTS_POLLPRI) result |= PollEventBitmask::ReadyToReceivePriorityData;
+    struct zts_sockaddr_storage senderSockaddr;
+    std::size_t receivedCount = 0;
+    ssize_t lastByteCount = 0;
+    for (; receivedCount < aDatagramCount; receivedCount += 1) {
+      auto& datagram = aDatagrams[receivedCount];
+      zts_socklen_t senderSockaddrLen = sizeof(senderSockaddr);
+      // Only the first call is allowed to block
+      const int flags = (receivedCount == 0) ? 0 : ZTS_MSG_DONTWAIT;
+      lastByteCount = callMaybeBlocking(flags == 0, [&]() {
+        return ZTCPP_TRACE_CALL("zts_bsd_recvfrom", _socketID, datagram.bufferByteSize,
+                                zts_bsd_recvfrom(_socketID,
+                                                 datagram.buffer, datagram.bufferByteSize,
+                                                 flags,
+                                                 reinterpret_cast<struct zts_sockaddr*>(&senderSockaddr),
+                                                 &senderSockaddrLen));
+      });
+      recordReceive(lastByteCount, true);
+      if (lastByteCount < 0) {
+        break;
+      }
+      datagram.bytesReceived = static_cast<std::size_t>(lastByteCount);
+      detail::ToIpAddressAndPort(&senderSockaddr, datagram.senderIpAddress, datagram.senderPort);
     }
 
-    return {result};
-  }
-
-  Result<IpAddress> getLocalIpAddress() const {
-    struct zts_sockaddr_storage localAddress;
-    zts_socklen_t localAddressLen = sizeof(localAddress);
-    const int res = zts_bsd_getsockname(_socketID,
-                                        reinterpret_cast<struct zts_sockaddr*>(&localAddress),
-                                        &localAddressLen);
-
-    if (res == ZTS_ERR_OK) {
-      IpAddress result;
-      uint16_t dummyPort;
-      detail::ToIpAddressAndPort(&localAddress, result, dummyPort);
-      return {result};
+    if (receivedCount > 0) {
+      return {receivedCount};
     }
-    if (res == ZTS_ERR_SOCKET) {
+    if (lastByteCount == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      return ResultWouldBlock();
+    }
+    if (lastByteCount == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
                                  "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (res == ZTS_ERR_SERVICE) {
+    if (lastByteCount == ZTS_ERR_SERVICE) {
       return {ZTCPP_ERROR_REPORT(ServiceError,
                                  "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (res == ZTS_ERR_ARG) {
+    if (lastByteCount == ZTS_ERR_ARG) {
       return {ZTCPP_ERROR_REPORT(ArgumentError,
                                  "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
 
     return {ZTCPP_ERROR_REPORT(GenericError,
-                               "Unknown error (zts_getsockname returned " + std::to_string(res) +
+                               "Unknown error (zts_bsd_recvfrom returned " + std::to_string(lastByteCount) +
                                ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  Result<uint16_t> getLocalPort() const {
-    struct zts_sockaddr_storage localAddress;
-    zts_socklen_t localAddressLen = sizeof(localAddress);
-    const int res = zts_bsd_getsockname(_socketID,
-                                        reinterpret_cast<struct zts_sockaddr*>(&localAddress),
-                                        &localAddressLen);
+  bool isOpen() const {
+    return (_socketID >= 0);
+  }
+
+  int getSocketID() const {
+    return _socketID;
+  }
+
+  EmptyResult setOption(int aLevel, int aOptionName, const void* aValue, std::size_t aValueSize) {
+    const int res = ZTCPP_TRACE_CALL("zts_bsd_setsockopt", _socketID, 0,
+                                     zts_bsd_setsockopt(_socketID, aLevel, aOptionName,
+                                                        aValue, static_cast<zts_socklen_t>(aValueSize)));
 
     if (res == ZTS_ERR_OK) {
-      IpAddress dummyAddress;
-      uint16_t result;
-      detail::ToIpAddressAndPort(&localAddress, dummyAddress, result);
-      return {result};
+      return EmptyResultOK();
     }
     if (res == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
@@ -463,22 +972,17 @@ public:
     }
 
     return {ZTCPP_ERROR_REPORT(GenericError,
-                               "Unknown error (zts_getsockname returned " + std::to_string(res) +
+                               "Unknown error (zts_bsd_setsockopt returned " + std::to_string(res) +
                                ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  Result<IpAddress> getRemoteIpAddress() const {
-    struct zts_sockaddr_storage localAddress;
-    zts_socklen_t localAddressLen = sizeof(localAddress);
-    const int res = zts_bsd_getpeername(_socketID,
-                                        reinterpret_cast<struct zts_sockaddr*>(&localAddress),
-                                        &localAddressLen);
+  EmptyResult getOption(int aLevel, int aOptionName, void* aValue, std::size_t aValueSize) const {
+    zts_socklen_t valueSize = static_cast<zts_socklen_t>(aValueSize);
+    const int res = ZTCPP_TRACE_CALL("zts_bsd_getsockopt", _socketID, 0,
+                                     zts_bsd_getsockopt(_socketID, aLevel, aOptionName, aValue, &valueSize));
 
     if (res == ZTS_ERR_OK) {
-      IpAddress result;
-      uint16_t dummyPort;
-      detail::ToIpAddressAndPort(&localAddress, result, dummyPort);
-      return {result};
+      return EmptyResultOK();
     }
     if (res == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
@@ -494,47 +998,292 @@ public:
     }
 
     return {ZTCPP_ERROR_REPORT(GenericError,
-                               "Unknown error (zts_getsockname returned " + std::to_string(res) +
+                               "Unknown error (zts_bsd_getsockopt returned " + std::to_string(res) +
                                ", zts_errno= " + std::to_string(zts_errno) + ")")};
   }
 
-  Result<uint16_t> getRemotePort() const {
-    struct zts_sockaddr_storage localAddress;
-    zts_socklen_t localAddressLen = sizeof(localAddress);
-    const int res = zts_bsd_getpeername(_socketID,
-                                        reinterpret_cast<struct zts_sockaddr*>(&localAddress),
-                                        &localAddressLen);
+  EmptyResult setIntOption(int aLevel, int aOptionName, int aValue) {
+    return setOption(aLevel, aOptionName, &aValue, sizeof(aValue));
+  }
 
-    if (res == ZTS_ERR_OK) {
-      IpAddress dummyAddress;
-      uint16_t result;
-      detail::ToIpAddressAndPort(&localAddress, dummyAddress, result);
-      return {result};
+  Result<int> getIntOption(int aLevel, int aOptionName) const {
+    int value = 0;
+    auto res = getOption(aLevel, aOptionName, &value, sizeof(value));
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
     }
-    if (res == ZTS_ERR_SOCKET) {
+    return {value};
+  }
+
+  EmptyResult setLinger(const LingerOption& aLinger) {
+    if (aLinger.timeout.count() < 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aLinger.timeout is negative")};
+    }
+    struct zts_linger linger;
+    linger.l_onoff  = aLinger.enabled ? 1 : 0;
+    linger.l_linger = static_cast<int>(aLinger.timeout.count());
+    return setOption(ZTS_SOL_SOCKET, ZTS_SO_LINGER, &linger, sizeof(linger));
+  }
+
+  Result<LingerOption> getLinger() const {
+    struct zts_linger linger;
+    auto res = getOption(ZTS_SOL_SOCKET, ZTS_SO_LINGER, &linger, sizeof(linger));
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {LingerOption{linger.l_onoff != 0, std::chrono::seconds{linger.l_linger}}};
+  }
+
+  EmptyResult setMulticastMembership(bool aJoin,
+                                     const IpAddress& aGroupAddress,
+                                     const IpAddress& aLocalInterfaceAddress) {
+    if (!aGroupAddress.isValid()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aGroupAddress is invalid")};
+    }
+    if (aGroupAddress.getAddressFamily() != getAddressFamily()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aGroupAddress is of wrong address family")};
+    }
+
+    if (_socketDomain == SocketDomain::InternetProtocol_IPv4) {
+      if (aLocalInterfaceAddress.isValid() &&
+          aLocalInterfaceAddress.getAddressFamily() != AddressFamily::IPv4) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "aLocalInterfaceAddress is of wrong address family")};
+      }
+      struct zts_ip_mreq request;
+      request.imr_multiaddr.s_addr = aGroupAddress.getIPv4AddressInNetworkOrder();
+      request.imr_interface.s_addr = aLocalInterfaceAddress.isValid()
+        ? aLocalInterfaceAddress.getIPv4AddressInNetworkOrder()
+        : ZTS_INADDR_ANY;
+      return setOption(ZTS_IPPROTO_IP,
+                       aJoin ? ZTS_IP_ADD_MEMBERSHIP : ZTS_IP_DROP_MEMBERSHIP,
+                       &request, sizeof(request));
+    }
+
+    struct zts_ipv6_mreq request;
+    const auto rawGroupAddress = aGroupAddress.getIPv6AddressInNetworkOrder();
+    std::memcpy(&request.ipv6mr_multiaddr, rawGroupAddress.bytes, sizeof(request.ipv6mr_multiaddr));
+    request.ipv6mr_interface = 0; // Let the stack choose
+    return setOption(ZTS_IPPROTO_IPV6,
+                     aJoin ? ZTS_IPV6_JOIN_GROUP : ZTS_IPV6_LEAVE_GROUP,
+                     &request, sizeof(request));
+  }
+
+  // Note: lwIP expects IPv4 multicast TTL and loopback options to be a single
+  // byte (not an int), while the IPv6 ones are ints.
+
+  EmptyResult setMulticastTTL(uint8_t aTTL) {
+    if (_socketDomain == SocketDomain::InternetProtocol_IPv4) {
+      return setOption(ZTS_IPPROTO_IP, ZTS_IP_MULTICAST_TTL, &aTTL, sizeof(aTTL));
+    }
+#ifdef ZTS_IPV6_MULTICAST_HOPS
+    return setIntOption(ZTS_IPPROTO_IPV6, ZTS_IPV6_MULTICAST_HOPS, aTTL);
+#else
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "Multicast hop limit is not supported for IPv6 sockets")};
+#endif
+  }
+
+  Result<uint8_t> getMulticastTTL() const {
+    if (_socketDomain == SocketDomain::InternetProtocol_IPv4) {
+      uint8_t ttl = 0;
+      auto res = getOption(ZTS_IPPROTO_IP, ZTS_IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      return {ttl};
+    }
+#ifdef ZTS_IPV6_MULTICAST_HOPS
+    auto res = getIntOption(ZTS_IPPROTO_IPV6, ZTS_IPV6_MULTICAST_HOPS);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {static_cast<uint8_t>(*res)};
+#else
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "Multicast hop limit is not supported for IPv6 sockets")};
+#endif
+  }
+
+  EmptyResult setMulticastLoopback(bool aLoopback) {
+    if (_socketDomain == SocketDomain::InternetProtocol_IPv4) {
+      const uint8_t value = aLoopback ? 1 : 0;
+      return setOption(ZTS_IPPROTO_IP, ZTS_IP_MULTICAST_LOOP, &value, sizeof(value));
+    }
+#ifdef ZTS_IPV6_MULTICAST_LOOP
+    return setIntOption(ZTS_IPPROTO_IPV6, ZTS_IPV6_MULTICAST_LOOP, aLoopback ? 1 : 0);
+#else
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "Multicast loopback is not supported for IPv6 sockets")};
+#endif
+  }
+
+  Result<bool> getMulticastLoopback() const {
+    if (_socketDomain == SocketDomain::InternetProtocol_IPv4) {
+      uint8_t value = 0;
+      auto res = getOption(ZTS_IPPROTO_IP, ZTS_IP_MULTICAST_LOOP, &value, sizeof(value));
+      if (!res) {
+        return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+      }
+      return {value != 0};
+    }
+#ifdef ZTS_IPV6_MULTICAST_LOOP
+    auto res = getIntOption(ZTS_IPPROTO_IPV6, ZTS_IPV6_MULTICAST_LOOP);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {*res != 0};
+#else
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "Multicast loopback is not supported for IPv6 sockets")};
+#endif
+  }
+
+  SocketStatistics getStatistics() const {
+    const auto load = [](const StatisticsCounter& aCounter) {
+      return aCounter.load(std::memory_order_relaxed);
+    };
+    SocketStatistics result;
+    result.bytesSent           = load(_statistics.bytesSent);
+    result.bytesReceived       = load(_statistics.bytesReceived);
+    result.sendCalls           = load(_statistics.sendCalls);
+    result.receiveCalls        = load(_statistics.receiveCalls);
+    result.partialWrites       = load(_statistics.partialWrites);
+    result.wouldBlockCount     = load(_statistics.wouldBlockCount);
+    result.socketErrors        = load(_statistics.socketErrors);
+    result.serviceErrors       = load(_statistics.serviceErrors);
+    result.argumentErrors      = load(_statistics.argumentErrors);
+    result.otherErrors         = load(_statistics.otherErrors);
+    result.connectionsAccepted = load(_statistics.connectionsAccepted);
+    result.timeBlocked = std::chrono::nanoseconds{
+      static_cast<std::chrono::nanoseconds::rep>(load(_statistics.nanosecondsBlocked))};
+    return result;
+  }
+
+  void resetStatistics() {
+    _statistics.reset();
+  }
+
+  EmptyResult close() {
+    forgetEndpoints();
+    if (isOpen()) {
+      const auto res = ZTCPP_TRACE_CALL("zts_close", _socketID, 0, zts_close(_socketID));
+      _socketID = ZTS_ERR_SOCKET;
+      detail::RecordSocketClosedMetric();
+
+      if (res == ZTS_ERR_SOCKET) {
+        return {ZTCPP_ERROR_REPORT(SocketError,
+                                   "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+      if (res == ZTS_ERR_SERVICE) {
+        return {ZTCPP_ERROR_REPORT(ServiceError,
+                                   "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+    }
+
+    return EmptyResultOK();
+  }
+
+  Result<int> pollEvents(PollEventBitmask::Enum aInterestedIn,
+                         std::chrono::milliseconds aMaxTimeToWait) const {
+    if (aInterestedIn == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aInterestedIn was 0")};
+    }
+
+    struct zts_pollfd pollfd;
+    pollfd.fd = _socketID;
+    pollfd.events = detail::ToZTPollEvents(aInterestedIn);
+
+    const int pollres = callMaybeBlocking(aMaxTimeToWait.count() != 0, [&]() {
+      return ZTCPP_TRACE_CALL("zts_bsd_poll", pollfd.fd, 0,
+                              zts_bsd_poll(&pollfd, 1, static_cast<int>(aMaxTimeToWait.count())));
+    });
+
+    if (pollres == ZTS_ERR_SOCKET) {
       return {ZTCPP_ERROR_REPORT(SocketError,
                                  "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (res == ZTS_ERR_SERVICE) {
+    if (pollres == ZTS_ERR_SERVICE) {
       return {ZTCPP_ERROR_REPORT(ServiceError,
                                  "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
     }
-    if (res == ZTS_ERR_ARG) {
-      return {ZTCPP_ERROR_REPORT(ArgumentError,
-                                 "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
+    if (pollres != 1 && pollres != 0) {
+      return {ZTCPP_ERROR_REPORT(GenericError,
+                                 "Unspecified error from zts_poll (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (pollfd.revents & ZTS_POLLNVAL) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "zts_poll returned ZTS_POLLNVAL (something wrong with socket descriptor)")};
+    }
+    if (pollfd.revents & ZTS_POLLHUP) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "zts_poll returned ZTS_POLLHUP (remote side of the connection hung up)")};
+    }
+    if (pollfd.revents & ZTS_POLLERR) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "zts_poll returned ZTS_POLLERR")};
     }
 
-    return {ZTCPP_ERROR_REPORT(GenericError,
-                               "Unknown error (zts_getpeername returned " + std::to_string(res) +
-                               ", zts_errno= " + std::to_string(zts_errno) + ")")};
+    int result = 0;
+    // If zts_poll returned 0, it means the socket wasn't 
+    // ready for any of the events we were interested in
+    if (pollres != 0) {
+      result = detail::FromZTPollEvents(pollfd.revents);
+    }
+
+    return {result};
+  }
+
+  Result<Endpoint> getLocalEndpoint() const {
+    return getCachedEndpoint(false, _localEndpoint);
+  }
+
+  Result<Endpoint> getRemoteEndpoint() const {
+    return getCachedEndpoint(true, _remoteEndpoint);
+  }
+
+  Result<IpAddress> getLocalIpAddress() const {
+    auto res = getLocalEndpoint();
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {(*res).getIpAddress()};
+  }
+
+  Result<uint16_t> getLocalPort() const {
+    auto res = getLocalEndpoint();
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {(*res).getPort()};
+  }
+
+  Result<IpAddress> getRemoteIpAddress() const {
+    auto res = getRemoteEndpoint();
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {(*res).getIpAddress()};
+  }
+
+  Result<uint16_t> getRemotePort() const {
+    auto res = getRemoteEndpoint();
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    return {(*res).getPort()};
   }
 
-#if 0
   EmptyResult setNonBlocking(bool aNonBlocking) {
-    int flags = zts_fcntl(_socketID, ZTS_F_GETFL, 0);
+    int flags = ZTCPP_TRACE_CALL("zts_bsd_fcntl", _socketID, 0,
+                                 zts_bsd_fcntl(_socketID, ZTS_F_GETFL, 0));
     if (flags < 0) {
       return {ZTCPP_ERROR_REPORT(GenericError, 
-                                 "Unspecified zts_fcntl() failure (" + std::to_string(flags) + ")")};
+                                 "Unspecified zts_bsd_fcntl() failure (" + std::to_string(flags) + ")")};
     }
 
     if (aNonBlocking) {
@@ -544,26 +1293,406 @@ public:
       flags &= ~ZTS_O_NONBLOCK;
     }
 
-    const int res = zts_fcntl(_socketID, ZTS_F_SETFL, flags);
+    const int res = ZTCPP_TRACE_CALL("zts_bsd_fcntl", _socketID, 0,
+                                     zts_bsd_fcntl(_socketID, ZTS_F_SETFL, flags));
     if (res < 0) {
       return {ZTCPP_ERROR_REPORT(GenericError, 
-                                 "Unspecified zts_fcntl() failure (" + std::to_string(res) + ")")};
+                                 "Unspecified zts_bsd_fcntl() failure (" + std::to_string(res) + ")")};
     }
 
     return EmptyResultOK();
   }
 
   Result<bool> getNonBlocking() const {
-    const int res = zts_fcntl(_socketID, ZTS_F_GETFL, 0);
+    const int res = ZTCPP_TRACE_CALL("zts_bsd_fcntl", _socketID, 0,
+                                     zts_bsd_fcntl(_socketID, ZTS_F_GETFL, 0));
     if (res < 0) {
       return {ZTCPP_ERROR_REPORT(GenericError, 
-                                 "Unspecified zts_fcntl() failure (" + std::to_string(res) + ")")};
+                                 "Unspecified zts_bsd_fcntl() failure (" + std::to_string(res) + ")")};
     }
     return {(res & ZTS_O_NONBLOCK) != 0};
   }
-#endif
 
 private:
+  //! Implementation of sendAll() and receiveExact(). aTransferred is updated as
+  //! the transfer progresses. Rather than going through send()/receive(), this
+  //! calls libzt directly so no Result objects are created per iteration.
+  Result<std::size_t> transferAll(const void* aBuffer,
+                                  std::size_t aByteCount,
+                                  Deadline aDeadline,
+                                  std::size_t& aTransferred,
+                                  bool aIsSend) {
+    if (aBuffer == nullptr || aByteCount == 0) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "Buffer is null or byte count == 0")};
+    }
+
+    const bool hasDeadline = (aDeadline != Deadline::max());
+    // With a deadline, libzt must never be allowed to block (we block in
+    // zts_bsd_poll instead, for no longer than the deadline allows)
+    const int flags = hasDeadline ? ZTS_MSG_DONTWAIT : 0;
+    const char* fnName = aIsSend ? "zts_send" : "zts_recv";
+
+    aTransferred = 0;
+    while (aTransferred < aByteCount) {
+      const auto byteCount = callMaybeBlocking(!hasDeadline, [&]() {
+        return aIsSend
+          ? ZTCPP_TRACE_CALL("zts_send", _socketID, aByteCount - aTransferred,
+                             zts_send(_socketID,
+                                      static_cast<const char*>(aBuffer) + aTransferred,
+                                      aByteCount - aTransferred,
+                                      flags))
+          : ZTCPP_TRACE_CALL("zts_recv", _socketID, aByteCount - aTransferred,
+                             zts_recv(_socketID,
+                                      const_cast<char*>(static_cast<const char*>(aBuffer)) + aTransferred,
+                                      aByteCount - aTransferred,
+                                      flags));
+      });
+      if (aIsSend) {
+        recordSend(byteCount, aByteCount - aTransferred);
+      }
+      else {
+        recordReceive(byteCount, true);
+      }
+
+      if (byteCount > 0) {
+        aTransferred += static_cast<std::size_t>(byteCount);
+        continue;
+      }
+      if (byteCount == 0 && !aIsSend) {
+        return {ZTCPP_ERROR_REPORT(SocketError,
+                                   "Connection closed by the remote after " +
+                                   std::to_string(aTransferred) + " of " +
+                                   std::to_string(aByteCount) + " bytes")};
+      }
+      if (byteCount == 0 || (byteCount == ZTS_ERR_SOCKET && lastCallWouldBlock())) {
+        // Wait until the socket is ready (or until the deadline passes)
+        int timeout = -1;
+        if (hasDeadline) {
+          const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+            aDeadline - std::chrono::steady_clock::now());
+          if (remaining.count() <= 0) {
+            return {ZTCPP_ERROR_REPORT(TimeoutError,
+                                       "Deadline passed after " + std::to_string(aTransferred) +
+                                       " of " + std::to_string(aByteCount) + " bytes")};
+          }
+          timeout = static_cast<int>(std::min<std::chrono::milliseconds::rep>(remaining.count(),
+                                                                              INT_MAX));
+        }
+        struct zts_pollfd pollfd;
+        pollfd.fd = _socketID;
+        pollfd.events = aIsSend ? ZTS_POLLOUT : ZTS_POLLIN;
+        pollfd.revents = 0;
+        const auto pollres = callMaybeBlocking(true, [&]() {
+          return ZTCPP_TRACE_CALL("zts_bsd_poll", pollfd.fd, 0, zts_bsd_poll(&pollfd, 1, timeout));
+        });
+        if (pollres >= 0) {
+          continue;
+        }
+        // Otherwise the next (non-blocking) attempt would fail right away again,
+        // so the loop would spin until the deadline
+        if (pollres == ZTS_ERR_SOCKET) {
+          return {ZTCPP_ERROR_REPORT(SocketError,
+                                     "zts_bsd_poll failed with ZTS_ERR_SOCKET after " +
+                                     std::to_string(aTransferred) + " bytes (zts_errno=" +
+                                     std::to_string(zts_errno) + ")")};
+        }
+        if (pollres == ZTS_ERR_SERVICE) {
+          return {ZTCPP_ERROR_REPORT(ServiceError,
+                                     "zts_bsd_poll failed with ZTS_ERR_SERVICE after " +
+                                     std::to_string(aTransferred) + " bytes (zts_errno=" +
+                                     std::to_string(zts_errno) + ")")};
+        }
+        if (pollres == ZTS_ERR_ARG) {
+          return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                     "zts_bsd_poll failed with ZTS_ERR_ARG after " +
+                                     std::to_string(aTransferred) + " bytes (zts_errno=" +
+                                     std::to_string(zts_errno) + ")")};
+        }
+        return {ZTCPP_ERROR_REPORT(GenericError,
+                                   "Unknown error (zts_bsd_poll returned " + std::to_string(pollres) +
+                                   ", zts_errno= " + std::to_string(zts_errno) + ")")};
+      }
+
+      if (byteCount == ZTS_ERR_SOCKET) {
+        return {ZTCPP_ERROR_REPORT(SocketError,
+                                   "ZTS_ERR_SOCKET after " + std::to_string(aTransferred) +
+                                   " bytes (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+      if (byteCount == ZTS_ERR_SERVICE) {
+        return {ZTCPP_ERROR_REPORT(ServiceError,
+                                   "ZTS_ERR_SERVICE after " + std::to_string(aTransferred) +
+                                   " bytes (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+      if (byteCount == ZTS_ERR_ARG) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "ZTS_ERR_ARG after " + std::to_string(aTransferred) +
+                                   " bytes (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+
+      return {ZTCPP_ERROR_REPORT(GenericError,
+                                 "Unknown error (" + std::string{fnName} + " returned " +
+                                 std::to_string(byteCount) + ", zts_errno= " +
+                                 std::to_string(zts_errno) + ")")};
+    }
+
+    return {aTransferred};
+  }
+
+  //! Looks up the local (zts_bsd_getsockname) or remote (zts_bsd_getpeername)
+  //! endpoint of the socket and stores it into aEndpoint.
+  EmptyResult queryEndpoint(bool aRemote, Endpoint& aEndpoint) const {
+    struct zts_sockaddr_storage address;
+    zts_socklen_t addressLen = sizeof(address);
+    const int res = aRemote
+      ? ZTCPP_TRACE_CALL("zts_bsd_getpeername", _socketID, 0,
+                         zts_bsd_getpeername(_socketID, reinterpret_cast<struct zts_sockaddr*>(&address), &addressLen))
+      : ZTCPP_TRACE_CALL("zts_bsd_getsockname", _socketID, 0,
+                         zts_bsd_getsockname(_socketID, reinterpret_cast<struct zts_sockaddr*>(&address), &addressLen));
+
+    if (res == ZTS_ERR_OK) {
+      detail::EndpointAccess::setFromSockaddr(aEndpoint, &address);
+      return EmptyResultOK();
+    }
+    if (res == ZTS_ERR_SOCKET) {
+      return {ZTCPP_ERROR_REPORT(SocketError,
+                                 "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (res == ZTS_ERR_SERVICE) {
+      return {ZTCPP_ERROR_REPORT(ServiceError,
+                                 "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+    if (res == ZTS_ERR_ARG) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
+    }
+
+    return {ZTCPP_ERROR_REPORT(GenericError,
+                               "Unknown error (" +
+                               std::string{aRemote ? "zts_getpeername" : "zts_getsockname"} +
+                               " returned " + std::to_string(res) +
+                               ", zts_errno= " + std::to_string(zts_errno) + ")")};
+  }
+
+  //! Return aCache if it's known, otherwise look the endpoint up. It's only
+  //! remembered if it's fully specified: an unbound socket reports an unspecified
+  //! endpoint (such as 0.0.0.0:0) which changes once the socket gets bound.
+  Result<Endpoint> getCachedEndpoint(bool aRemote, Endpoint& aCache) const {
+    if (aCache.isValid()) {
+      return {aCache};
+    }
+    Endpoint endpoint;
+    auto res = queryEndpoint(aRemote, endpoint);
+    if (!res) {
+      return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+    }
+    if (IsFullySpecified(endpoint)) {
+      aCache = endpoint;
+    }
+    return {endpoint};
+  }
+
+  void forgetEndpoints() {
+    _localEndpoint = Endpoint{};
+    _remoteEndpoint = Endpoint{};
+  }
+
+  //! Blocks until any of aZTEvents (ZTS_POLL* flags) occurs on the socket, or
+  //! until aDeadline passes (TimeoutError). Error conditions on the socket count
+  //! as ready, so that the following operation can report them.
+  EmptyResult waitUntilReady(short aZTEvents, Deadline aDeadline) const {
+    while (true) {
+      const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        aDeadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0) {
+        return {ZTCPP_ERROR_REPORT(TimeoutError, "Deadline passed")};
+      }
+      const int timeout = static_cast<int>(std::min<std::chrono::milliseconds::rep>(remaining.count(),
+                                                                                    INT_MAX));
+
+      struct zts_pollfd pollfd;
+      pollfd.fd = _socketID;
+      pollfd.events = aZTEvents;
+      pollfd.revents = 0;
+      const auto res = callMaybeBlocking(true, [&]() {
+        return ZTCPP_TRACE_CALL("zts_bsd_poll", pollfd.fd, 0, zts_bsd_poll(&pollfd, 1, timeout));
+      });
+
+      if (res > 0) {
+        return EmptyResultOK();
+      }
+      if (res == 0) {
+        continue; // Timed out; the loop will report it (or keep waiting if woken early)
+      }
+      if (res == ZTS_ERR_SOCKET) {
+        return {ZTCPP_ERROR_REPORT(SocketError,
+                                   "ZTS_ERR_SOCKET (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+      if (res == ZTS_ERR_SERVICE) {
+        return {ZTCPP_ERROR_REPORT(ServiceError,
+                                   "ZTS_ERR_SERVICE (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+      if (res == ZTS_ERR_ARG) {
+        return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                   "ZTS_ERR_ARG (zts_errno=" + std::to_string(zts_errno) + ")")};
+      }
+
+      return {ZTCPP_ERROR_REPORT(GenericError,
+                                 "Unknown error (zts_bsd_poll returned " + std::to_string(res) +
+                                 ", zts_errno= " + std::to_string(zts_errno) + ")")};
+    }
+  }
+
+  //! Returns true if accept() can be called without blocking.
+  bool hasPendingConnection() const {
+    struct zts_pollfd pollfd;
+    pollfd.fd = _socketID;
+    pollfd.events = ZTS_POLLIN;
+    pollfd.revents = 0;
+    const int res = ZTCPP_TRACE_CALL("zts_bsd_poll", pollfd.fd, 0, zts_bsd_poll(&pollfd, 1, 0));
+    return (res > 0 && (pollfd.revents & ZTS_POLLIN) != 0);
+  }
+
+  //! Second half of a non-blocking connect(): waits until the socket becomes
+  //! writable and then checks SO_ERROR to see if the connection succeeded.
+  EmptyResult finishConnect(Deadline aDeadline) {
+    auto waitRes = waitUntilReady(ZTS_POLLOUT, aDeadline);
+    if (!waitRes) {
+      return waitRes;
+    }
+    return finishConnect();
+  }
+
+  //! Receives with zts_recv() or zts_bsd_recvfrom() (if aSender is not null). If
+  //! the caller wants to know about truncation, zts_bsd_recvmsg() is used instead,
+  //! as it's the only one of the three that reports it.
+  ssize_t receiveRaw(void* aDestinationBuffer,
+                     std::size_t aDestinationBufferByteSize,
+                     int aZTFlags,
+                     struct zts_sockaddr_storage* aSender,
+                     zts_socklen_t* aSenderLen,
+                     bool* aTruncated) {
+    const auto byteCount = callMaybeBlocking((aZTFlags & ZTS_MSG_DONTWAIT) == 0, [&]() {
+      return receiveUntracked(aDestinationBuffer, aDestinationBufferByteSize,
+                              aZTFlags, aSender, aSenderLen, aTruncated);
+    });
+    // Peeked data will be received (and counted) again
+    recordReceive(byteCount, (aZTFlags & ZTS_MSG_PEEK) == 0);
+    return byteCount;
+  }
+
+  ssize_t receiveUntracked(void* aDestinationBuffer,
+                           std::size_t aDestinationBufferByteSize,
+                           int aZTFlags,
+                           struct zts_sockaddr_storage* aSender,
+                           zts_socklen_t* aSenderLen,
+                           bool* aTruncated) {
+    if (aTruncated == nullptr) {
+      if (aSender == nullptr) {
+        return ZTCPP_TRACE_CALL("zts_recv", _socketID, aDestinationBufferByteSize,
+                                zts_recv(_socketID, aDestinationBuffer, aDestinationBufferByteSize, aZTFlags));
+      }
+      return ZTCPP_TRACE_CALL("zts_bsd_recvfrom", _socketID, aDestinationBufferByteSize,
+                              zts_bsd_recvfrom(_socketID,
+                                               aDestinationBuffer, aDestinationBufferByteSize,
+                                               aZTFlags,
+                                               reinterpret_cast<struct zts_sockaddr*>(aSender),
+                                               aSenderLen));
+    }
+
+    struct zts_iovec iovec;
+    iovec.iov_base = aDestinationBuffer;
+    iovec.iov_len  = aDestinationBufferByteSize;
+
+    struct zts_msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_name    = aSender;
+    message.msg_namelen = (aSenderLen != nullptr) ? *aSenderLen : 0;
+    message.msg_iov     = &iovec;
+    message.msg_iovlen  = 1;
+
+    const auto byteCount = ZTCPP_TRACE_CALL("zts_bsd_recvmsg", _socketID, aDestinationBufferByteSize,
+                                            zts_bsd_recvmsg(_socketID, &message, aZTFlags));
+    if (aSenderLen != nullptr) {
+      *aSenderLen = message.msg_namelen;
+    }
+    *aTruncated = (byteCount >= 0 && (message.msg_flags & ZT_MSG_TRUNC) != 0);
+    return byteCount;
+  }
+
+  //! Call right after a zts_* function returns ZTS_ERR_SOCKET to check whether
+  //! it failed only because the operation would block on a non-blocking socket.
+  static bool lastCallWouldBlock() {
+    return (zts_errno == ZTS_EAGAIN || zts_errno == ZTS_EWOULDBLOCK);
+  }
+
+  ///// STATISTICS /////
+
+  //! Returns the result of aCall (a call into libzt). If aMayBlock is true, the
+  //! time spent in the call is added to the time blocked (reading the clock is
+  //! skipped for calls which can't block anyway).
+  template <class taCall>
+  auto callMaybeBlocking(bool aMayBlock, taCall&& aCall) const -> decltype(aCall()) {
+    if (!aMayBlock) {
+      return aCall();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = aCall();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    AddToCounter(_statistics.nanosecondsBlocked,
+                 static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    return result;
+  }
+
+  //! Call right after a zts_* function which sends data.
+  void recordSend(ssize_t aResult, std::size_t aRequestedByteCount) const {
+    AddToCounter(_statistics.sendCalls, 1);
+    if (aResult < 0) {
+      recordFailure(aResult);
+      return;
+    }
+    AddToCounter(_statistics.bytesSent, static_cast<uint64_t>(aResult));
+    detail::RecordBytesSentMetric(static_cast<uint64_t>(aResult));
+    if (static_cast<std::size_t>(aResult) < aRequestedByteCount) {
+      AddToCounter(_statistics.partialWrites, 1);
+    }
+  }
+
+  //! Call right after a zts_* function which receives data.
+  void recordReceive(ssize_t aResult, bool aCountBytes) const {
+    AddToCounter(_statistics.receiveCalls, 1);
+    if (aResult < 0) {
+      recordFailure(aResult);
+      return;
+    }
+    if (aCountBytes) {
+      AddToCounter(_statistics.bytesReceived, static_cast<uint64_t>(aResult));
+      detail::RecordBytesReceivedMetric(static_cast<uint64_t>(aResult));
+    }
+  }
+
+  //! Call right after a zts_* function fails (classifies the failure).
+  //! Other errors reach the library-wide metrics through ZTCPP_ERROR_REPORT, but
+  //! would-block results don't create error reports, so they're counted here.
+  void recordFailure(ssize_t aResult) const {
+    if (aResult == ZTS_ERR_SOCKET && lastCallWouldBlock()) {
+      AddToCounter(_statistics.wouldBlockCount, 1);
+      detail::RecordErrorMetric(ErrorCode::WouldBlock);
+    }
+    else if (aResult == ZTS_ERR_SOCKET) {
+      AddToCounter(_statistics.socketErrors, 1);
+    }
+    else if (aResult == ZTS_ERR_SERVICE) {
+      AddToCounter(_statistics.serviceErrors, 1);
+    }
+    else if (aResult == ZTS_ERR_ARG) {
+      AddToCounter(_statistics.argumentErrors, 1);
+    }
+    else {
+      AddToCounter(_statistics.otherErrors, 1);
+    }
+  }
+
   AddressFamily getAddressFamily() {
     switch (_socketDomain) {
     case SocketDomain::InternetProtocol_IPv4: return AddressFamily::IPv4;
@@ -594,95 +1723,513 @@ private:
   SocketDomain _socketDomain = static_cast<SocketDomain>(-1);
   SocketType _socketType = static_cast<SocketType>(-1);
   int _socketID = ZTS_ERR_SOCKET;
-};
 
-Socket::Socket()
-  : _impl{std::make_unique<Impl>()}
-{
-}
+  // Cached endpoints (invalid until known). Filled in lazily by const getters,
+  // which is why Socket isn't safe for concurrent use even through const methods
+  mutable Endpoint _localEndpoint;
+  mutable Endpoint _remoteEndpoint;
+
+  struct StatisticsCounters {
+    StatisticsCounter bytesSent{0};
+    StatisticsCounter bytesReceived{0};
+    StatisticsCounter sendCalls{0};
+    StatisticsCounter receiveCalls{0};
+    StatisticsCounter partialWrites{0};
+    StatisticsCounter wouldBlockCount{0};
+    StatisticsCounter socketErrors{0};
+    StatisticsCounter serviceErrors{0};
+    StatisticsCounter argumentErrors{0};
+    StatisticsCounter otherErrors{0};
+    StatisticsCounter connectionsAccepted{0};
+    StatisticsCounter nanosecondsBlocked{0};
+
+    static constexpr StatisticsCounter StatisticsCounters::* ALL[] = {
+      &StatisticsCounters::bytesSent,
+      &StatisticsCounters::bytesReceived,
+      &StatisticsCounters::sendCalls,
+      &StatisticsCounters::receiveCalls,
+      &StatisticsCounters::partialWrites,
+      &StatisticsCounters::wouldBlockCount,
+      &StatisticsCounters::socketErrors,
+      &StatisticsCounters::serviceErrors,
+      &StatisticsCounters::argumentErrors,
+      &StatisticsCounters::otherErrors,
+      &StatisticsCounters::connectionsAccepted,
+      &StatisticsCounters::nanosecondsBlocked
+    };
+
+    void copyFrom(const StatisticsCounters& aOther) {
+      for (auto counter : ALL) {
+        (this->*counter).store((aOther.*counter).load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+      }
+    }
+
+    void reset() {
+      for (auto counter : ALL) {
+        (this->*counter).store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  // Mutable because calls made from const methods (such as pollEvents()) are counted too
+  mutable StatisticsCounters _statistics;
+};
 
 ///////////////////////////////////////////////////////////////////////////
 // SOCKET                                                                //
 ///////////////////////////////////////////////////////////////////////////
 
-Socket::~Socket() = default;
+Socket::Socket() {
+  static_assert(sizeof(Impl) <= IMPL_STORAGE_SIZE,
+                "Socket::IMPL_STORAGE_SIZE is too small for Socket::Impl");
+  static_assert(alignof(Impl) <= IMPL_STORAGE_ALIGNMENT,
+                "Socket::IMPL_STORAGE_ALIGNMENT is too small for Socket::Impl");
+  new (_implStorage) Impl();
+}
+
+Socket::Socket(Impl&& aImpl) {
+  new (_implStorage) Impl(std::move(aImpl));
+}
+
+Socket::~Socket() {
+  getImpl().~Impl();
+}
+
+Socket::Socket(Socket&& aOther) noexcept {
+  new (_implStorage) Impl(std::move(aOther.getImpl()));
+}
 
-Socket::Socket(Socket&&) = default;
+Socket& Socket::operator=(Socket&& aOther) noexcept {
+  getImpl() = std::move(aOther.getImpl());
+  return *this;
+}
 
-Socket& Socket::operator=(Socket&&) = default;
+Socket::Impl& Socket::getImpl() {
+  return *std::launder(reinterpret_cast<Impl*>(_implStorage));
+}
+
+const Socket::Impl& Socket::getImpl() const {
+  return *std::launder(reinterpret_cast<const Impl*>(_implStorage));
+}
 
 EmptyResult Socket::init(SocketDomain aSocketDomain, SocketType aSocketType) {
-  return _impl->init(aSocketDomain, aSocketType);
+  return getImpl().init(aSocketDomain, aSocketType);
 }
 
 EmptyResult Socket::bind(const IpAddress & aLocalIpAddress, uint16_t aLocalPortInHostOrder) {
-  return _impl->bind(aLocalIpAddress, aLocalPortInHostOrder);
+  return getImpl().bind(aLocalIpAddress, aLocalPortInHostOrder);
 }
 
 EmptyResult Socket::connect(const IpAddress& aRemoteIpAddress,
                             uint16_t aRemotePortInHostOrder) {
-    return _impl->connect(aRemoteIpAddress, aRemotePortInHostOrder);
+    return getImpl().connect(aRemoteIpAddress, aRemotePortInHostOrder);
+}
+
+EmptyResult Socket::connect(const IpAddress& aRemoteIpAddress,
+                            uint16_t aRemotePortInHostOrder,
+                            Deadline aDeadline) {
+  return getImpl().connect(aRemoteIpAddress, aRemotePortInHostOrder, aDeadline);
+}
+
+EmptyResult Socket::connect(const IpAddress& aRemoteIpAddress,
+                            uint16_t aRemotePortInHostOrder,
+                            std::chrono::milliseconds aTimeout) {
+  return getImpl().connect(aRemoteIpAddress, aRemotePortInHostOrder,
+                        std::chrono::steady_clock::now() + aTimeout);
+}
+
+EmptyResult Socket::finishConnect() {
+  return getImpl().finishConnect();
 }
 
 EmptyResult Socket::listen(std::size_t aMaxQueueSize) {
-  return _impl->listen(aMaxQueueSize);
+  return getImpl().listen(aMaxQueueSize);
 }
 
 Result<Socket> Socket::accept() {
-  return _impl->accept();
+  return getImpl().accept(nullptr, nullptr);
+}
+
+Result<Socket> Socket::accept(IpAddress& aRemoteIpAddress, uint16_t& aRemotePort) {
+  return getImpl().accept(&aRemoteIpAddress, &aRemotePort);
+}
+
+Result<std::size_t> Socket::acceptMany(std::vector<AcceptedConnection>& aConnections,
+                                       std::size_t aMaxCount) {
+  return getImpl().acceptMany(aConnections, aMaxCount);
+}
+
+Result<Socket> Socket::accept(Deadline aDeadline) {
+  return getImpl().accept(aDeadline);
+}
+
+Result<Socket> Socket::accept(std::chrono::milliseconds aTimeout) {
+  return getImpl().accept(std::chrono::steady_clock::now() + aTimeout);
 }
 
 Result<std::size_t> Socket::send(const void* aData,
                                  std::size_t aDataByteSize) {
-    return _impl->send(aData, aDataByteSize);
+    return getImpl().send(aData, aDataByteSize, IoFlags::None);
+}
+
+Result<std::size_t> Socket::send(const void* aData,
+                                 std::size_t aDataByteSize,
+                                 int aFlags) {
+    return getImpl().send(aData, aDataByteSize, aFlags);
+}
+
+Result<std::size_t> Socket::send(const void* aData,
+                                 std::size_t aDataByteSize,
+                                 Deadline aDeadline) {
+    return getImpl().send(aData, aDataByteSize, aDeadline);
+}
+
+Result<std::size_t> Socket::send(const void* aData,
+                                 std::size_t aDataByteSize,
+                                 std::chrono::milliseconds aTimeout) {
+    return getImpl().send(aData, aDataByteSize, std::chrono::steady_clock::now() + aTimeout);
+}
+
+Result<std::size_t> Socket::sendAll(const void* aData,
+                                    std::size_t aDataByteSize,
+                                    Deadline aDeadline,
+                                    std::size_t* aBytesSent) {
+  return getImpl().sendAll(aData, aDataByteSize, aDeadline, aBytesSent);
+}
+
+Result<std::size_t> Socket::receiveExact(void* aDestinationBuffer,
+                                         std::size_t aByteCount,
+                                         Deadline aDeadline,
+                                         std::size_t* aBytesReceived) {
+  return getImpl().receiveExact(aDestinationBuffer, aByteCount, aDeadline, aBytesReceived);
+}
+
+Result<std::size_t> Socket::sendv(const ConstBufferSegment* aSegments,
+                                  std::size_t aSegmentCount) {
+  return getImpl().sendv(aSegments, aSegmentCount);
 }
 
 Result<std::size_t> Socket::sendTo(const void* aData,
                                    std::size_t aDataByteSize,
                                    const IpAddress & aRemoteIpAddress,
                                    uint16_t aRemotePortInHostOrder) {
-  return _impl->sendTo(aData, aDataByteSize, aRemoteIpAddress, aRemotePortInHostOrder);
+  return getImpl().sendTo(aData, aDataByteSize, aRemoteIpAddress, aRemotePortInHostOrder);
+}
+
+Result<std::size_t> Socket::sendTo(const void* aData,
+                                   std::size_t aDataByteSize,
+                                   const Endpoint& aRemoteEndpoint) {
+  return getImpl().sendTo(aData, aDataByteSize, aRemoteEndpoint);
+}
+
+Result<std::size_t> Socket::sendToMany(OutgoingDatagram* aDatagrams,
+                                       std::size_t aDatagramCount) {
+  return getImpl().sendToMany(aDatagrams, aDatagramCount);
 }
 
 Result<std::size_t> Socket::receive(void* aDestinationBuffer,
                                     std::size_t aDestinationBufferByteSize) {
-    return _impl->receive(aDestinationBuffer, aDestinationBufferByteSize);
+    return getImpl().receive(aDestinationBuffer, aDestinationBufferByteSize, IoFlags::None, nullptr);
+}
+
+Result<std::size_t> Socket::receive(void* aDestinationBuffer,
+                                    std::size_t aDestinationBufferByteSize,
+                                    int aFlags,
+                                    bool* aTruncated) {
+    return getImpl().receive(aDestinationBuffer, aDestinationBufferByteSize, aFlags, aTruncated);
+}
+
+Result<std::size_t> Socket::receive(void* aDestinationBuffer,
+                                    std::size_t aDestinationBufferByteSize,
+                                    Deadline aDeadline) {
+    return getImpl().receive(aDestinationBuffer, aDestinationBufferByteSize, aDeadline);
+}
+
+Result<std::size_t> Socket::receive(void* aDestinationBuffer,
+                                    std::size_t aDestinationBufferByteSize,
+                                    std::chrono::milliseconds aTimeout) {
+    return getImpl().receive(aDestinationBuffer, aDestinationBufferByteSize,
+                          std::chrono::steady_clock::now() + aTimeout);
+}
+
+Result<Buffer> Socket::receive(BufferPool& aBufferPool) {
+  auto buffer = aBufferPool.acquire();
+  if (!buffer) {
+    return {std::move(buffer)};
+  }
+  auto res = getImpl().receive((*buffer).getData(), (*buffer).getCapacity(), IoFlags::None, nullptr);
+  if (res.wouldBlock()) {
+    return ResultWouldBlock();
+  }
+  if (!res) {
+    return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+  }
+  (*buffer).setSize(*res);
+  return {std::move(*buffer)};
+}
+
+Result<std::size_t> Socket::receivev(const BufferSegment* aSegments,
+                                     std::size_t aSegmentCount) {
+  return getImpl().receivev(aSegments, aSegmentCount);
 }
 
 Result<std::size_t> Socket::receiveFrom(void* aDestinationBuffer,
                                         std::size_t aDestinationBufferByteSize,
                                         IpAddress& aSenderAddress,
                                         uint16_t& aSenderPort) {
-  return _impl->receiveFrom(aDestinationBuffer, aDestinationBufferByteSize, aSenderAddress, aSenderPort);
+  return getImpl().receiveFrom(aDestinationBuffer, aDestinationBufferByteSize, aSenderAddress, aSenderPort,
+                            IoFlags::None, nullptr);
+}
+
+Result<std::size_t> Socket::receiveFrom(void* aDestinationBuffer,
+                                        std::size_t aDestinationBufferByteSize,
+                                        IpAddress& aSenderAddress,
+                                        uint16_t& aSenderPort,
+                                        int aFlags,
+                                        bool* aTruncated) {
+  return getImpl().receiveFrom(aDestinationBuffer, aDestinationBufferByteSize, aSenderAddress, aSenderPort,
+                            aFlags, aTruncated);
+}
+
+Result<std::size_t> Socket::receiveFrom(void* aDestinationBuffer,
+                                        std::size_t aDestinationBufferByteSize,
+                                        Endpoint& aSenderEndpoint,
+                                        int aFlags,
+                                        bool* aTruncated) {
+  return getImpl().receiveFrom(aDestinationBuffer, aDestinationBufferByteSize, aSenderEndpoint,
+                               aFlags, aTruncated);
+}
+
+Result<Buffer> Socket::receiveFrom(BufferPool& aBufferPool,
+                                   IpAddress& aSenderAddress,
+                                   uint16_t& aSenderPort) {
+  auto buffer = aBufferPool.acquire();
+  if (!buffer) {
+    return {std::move(buffer)};
+  }
+  auto res = getImpl().receiveFrom((*buffer).getData(), (*buffer).getCapacity(),
+                                aSenderAddress, aSenderPort, IoFlags::None, nullptr);
+  if (res.wouldBlock()) {
+    return ResultWouldBlock();
+  }
+  if (!res) {
+    return {std::make_unique<ErrorReport>(std::move(res.getError()))};
+  }
+  (*buffer).setSize(*res);
+  return {std::move(*buffer)};
+}
+
+Result<std::size_t> Socket::receiveFromMany(IncomingDatagram* aDatagrams,
+                                            std::size_t aDatagramCount) {
+  return getImpl().receiveFromMany(aDatagrams, aDatagramCount);
 }
 
 bool Socket::isOpen() const {
-  return _impl->isOpen();
+  return getImpl().isOpen();
 }
 
 EmptyResult Socket::close() {
-  return _impl->close();
+  return getImpl().close();
+}
+
+EmptyResult Socket::setNonBlocking(bool aNonBlocking) {
+  return getImpl().setNonBlocking(aNonBlocking);
+}
+
+Result<bool> Socket::getNonBlocking() const {
+  return getImpl().getNonBlocking();
 }
 
 Result<int> Socket::pollEvents(PollEventBitmask::Enum aInterestedIn,
                                std::chrono::milliseconds aMaxTimeToWait) const {
-  return _impl->pollEvents(aInterestedIn, aMaxTimeToWait);
+  return getImpl().pollEvents(aInterestedIn, aMaxTimeToWait);
+}
+
+Result<Endpoint> Socket::getLocalEndpoint() const {
+  return getImpl().getLocalEndpoint();
+}
+
+Result<Endpoint> Socket::getRemoteEndpoint() const {
+  return getImpl().getRemoteEndpoint();
 }
 
 Result<IpAddress> Socket::getLocalIpAddress() const {
-  return _impl->getLocalIpAddress();
+  return getImpl().getLocalIpAddress();
 }
 
 Result<uint16_t> Socket::getLocalPort() const {
-  return _impl->getLocalPort();
+  return getImpl().getLocalPort();
 }
 
 Result<IpAddress> Socket::getRemoteIpAddress() const {
-  return _impl->getRemoteIpAddress();
+  return getImpl().getRemoteIpAddress();
 }
 
 Result<uint16_t> Socket::getRemotePort() const {
-  return _impl->getRemotePort();
+  return getImpl().getRemotePort();
+}
+
+namespace {
+
+//! Converts a Result<int> holding a socket option's value into a Result holding
+//! the value converted into the type exposed by the public API.
+template <class taValue>
+Result<taValue> ConvertOptionValue(Result<int> aResult) {
+  if (!aResult) {
+    return {std::make_unique<ErrorReport>(std::move(aResult.getError()))};
+  }
+  return {static_cast<taValue>(*aResult)};
+}
+
+template <>
+Result<bool> ConvertOptionValue<bool>(Result<int> aResult) {
+  if (!aResult) {
+    return {std::make_unique<ErrorReport>(std::move(aResult.getError()))};
+  }
+  return {*aResult != 0};
+}
+
+} // namespace
+
+EmptyResult Socket::setNoDelay(bool aNoDelay) {
+  return getImpl().setIntOption(ZTS_IPPROTO_TCP, ZTS_TCP_NODELAY, aNoDelay ? 1 : 0);
+}
+
+Result<bool> Socket::getNoDelay() const {
+  return ConvertOptionValue<bool>(getImpl().getIntOption(ZTS_IPPROTO_TCP, ZTS_TCP_NODELAY));
+}
+
+EmptyResult Socket::setSendBufferSize(std::size_t aByteSize) {
+  if (aByteSize > static_cast<std::size_t>(INT_MAX)) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aByteSize is too large")};
+  }
+  return getImpl().setIntOption(ZTS_SOL_SOCKET, ZTS_SO_SNDBUF, static_cast<int>(aByteSize));
+}
+
+Result<std::size_t> Socket::getSendBufferSize() const {
+  return ConvertOptionValue<std::size_t>(getImpl().getIntOption(ZTS_SOL_SOCKET, ZTS_SO_SNDBUF));
+}
+
+EmptyResult Socket::setReceiveBufferSize(std::size_t aByteSize) {
+  if (aByteSize > static_cast<std::size_t>(INT_MAX)) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "aByteSize is too large")};
+  }
+  return getImpl().setIntOption(ZTS_SOL_SOCKET, ZTS_SO_RCVBUF, static_cast<int>(aByteSize));
+}
+
+Result<std::size_t> Socket::getReceiveBufferSize() const {
+  return ConvertOptionValue<std::size_t>(getImpl().getIntOption(ZTS_SOL_SOCKET, ZTS_SO_RCVBUF));
+}
+
+EmptyResult Socket::setKeepAlive(bool aKeepAlive) {
+  return getImpl().setIntOption(ZTS_SOL_SOCKET, ZTS_SO_KEEPALIVE, aKeepAlive ? 1 : 0);
+}
+
+Result<bool> Socket::getKeepAlive() const {
+  return ConvertOptionValue<bool>(getImpl().getIntOption(ZTS_SOL_SOCKET, ZTS_SO_KEEPALIVE));
+}
+
+EmptyResult Socket::setKeepAliveParameters(std::chrono::seconds aIdleTime,
+                                           std::chrono::seconds aProbeInterval,
+                                           int aProbeCount) {
+  if (aIdleTime.count() <= 0 || aProbeInterval.count() <= 0 || aProbeCount <= 0) {
+    return {ZTCPP_ERROR_REPORT(ArgumentError,
+                               "All keep-alive parameters must be positive")};
+  }
+  {
+    auto res = getImpl().setIntOption(ZTS_IPPROTO_TCP, ZTS_TCP_KEEPIDLE,
+                                   static_cast<int>(aIdleTime.count()));
+    if (!res) {
+      return res;
+    }
+  }
+  {
+    auto res = getImpl().setIntOption(ZTS_IPPROTO_TCP, ZTS_TCP_KEEPINTVL,
+                                   static_cast<int>(aProbeInterval.count()));
+    if (!res) {
+      return res;
+    }
+  }
+  return getImpl().setIntOption(ZTS_IPPROTO_TCP, ZTS_TCP_KEEPCNT, aProbeCount);
+}
+
+EmptyResult Socket::setLinger(const LingerOption& aLinger) {
+  return getImpl().setLinger(aLinger);
+}
+
+Result<Socket::LingerOption> Socket::getLinger() const {
+  return getImpl().getLinger();
+}
+
+EmptyResult Socket::setReuseAddress(bool aReuseAddress) {
+  return getImpl().setIntOption(ZTS_SOL_SOCKET, ZTS_SO_REUSEADDR, aReuseAddress ? 1 : 0);
+}
+
+Result<bool> Socket::getReuseAddress() const {
+  return ConvertOptionValue<bool>(getImpl().getIntOption(ZTS_SOL_SOCKET, ZTS_SO_REUSEADDR));
+}
+
+EmptyResult Socket::setTypeOfService(uint8_t aTypeOfService) {
+  return getImpl().setIntOption(ZTS_IPPROTO_IP, ZTS_IP_TOS, aTypeOfService);
+}
+
+Result<uint8_t> Socket::getTypeOfService() const {
+  return ConvertOptionValue<uint8_t>(getImpl().getIntOption(ZTS_IPPROTO_IP, ZTS_IP_TOS));
+}
+
+EmptyResult Socket::setBroadcast(bool aBroadcast) {
+  return getImpl().setIntOption(ZTS_SOL_SOCKET, ZTS_SO_BROADCAST, aBroadcast ? 1 : 0);
+}
+
+Result<bool> Socket::getBroadcast() const {
+  return ConvertOptionValue<bool>(getImpl().getIntOption(ZTS_SOL_SOCKET, ZTS_SO_BROADCAST));
+}
+
+EmptyResult Socket::joinMulticastGroup(const IpAddress& aGroupAddress,
+                                       const IpAddress& aLocalInterfaceAddress) {
+  return getImpl().setMulticastMembership(true, aGroupAddress, aLocalInterfaceAddress);
+}
+
+EmptyResult Socket::leaveMulticastGroup(const IpAddress& aGroupAddress,
+                                        const IpAddress& aLocalInterfaceAddress) {
+  return getImpl().setMulticastMembership(false, aGroupAddress, aLocalInterfaceAddress);
+}
+
+EmptyResult Socket::setMulticastTTL(uint8_t aTTL) {
+  return getImpl().setMulticastTTL(aTTL);
+}
+
+Result<uint8_t> Socket::getMulticastTTL() const {
+  return getImpl().getMulticastTTL();
+}
+
+EmptyResult Socket::setMulticastLoopback(bool aLoopback) {
+  return getImpl().setMulticastLoopback(aLoopback);
+}
+
+Result<bool> Socket::getMulticastLoopback() const {
+  return getImpl().getMulticastLoopback();
+}
+
+SocketStatistics Socket::getStatistics() const {
+  return getImpl().getStatistics();
+}
+
+void Socket::resetStatistics() {
+  getImpl().resetStatistics();
+}
+
+///////////////////////////////////////////////////////////////////////////
+// DETAIL                                                                //
+///////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+int GetSocketID(const Socket& aSocket) {
+  return aSocket.getImpl().getSocketID();
 }
+} // namespace detail
 
 ZTCPP_NAMESPACE_END
\ No newline at end of file
@@ -0,0 +1,393 @@
+#include <ZTCpp/Tcp_server.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#elif defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+//! Pins the thread to the aCoreIndex-th core (modulo the number of cores) out of
+//! the ones the process is allowed to run on.
+//! Returns false if pinning is not supported on this platform or if it failed.
+bool PinThreadToCore(std::thread& aThread, std::size_t aCoreIndex) {
+#if defined(_WIN32)
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask) || processMask == 0) {
+    return false;
+  }
+  std::size_t allowedCount = 0;
+  for (DWORD_PTR mask = processMask; mask != 0; mask &= (mask - 1)) {
+    allowedCount += 1;
+  }
+  std::size_t remaining = aCoreIndex % allowedCount;
+  for (std::size_t core = 0; core < sizeof(DWORD_PTR) * 8; core += 1) {
+    const DWORD_PTR mask = static_cast<DWORD_PTR>(1) << core;
+    if ((processMask & mask) != 0 && remaining-- == 0) {
+      return SetThreadAffinityMask(aThread.native_handle(), mask) != 0;
+    }
+  }
+  return false;
+#elif defined(__linux__)
+  cpu_set_t allowedSet;
+  CPU_ZERO(&allowedSet);
+  if (sched_getaffinity(0, sizeof(allowedSet), &allowedSet) != 0) {
+    return false;
+  }
+  const int allowedCount = CPU_COUNT(&allowedSet);
+  if (allowedCount <= 0) {
+    return false;
+  }
+  std::size_t remaining = aCoreIndex % static_cast<std::size_t>(allowedCount);
+  for (int core = 0; core < CPU_SETSIZE; core += 1) {
+    if (CPU_ISSET(core, &allowedSet) && remaining-- == 0) {
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(core, &cpuSet);
+      return pthread_setaffinity_np(aThread.native_handle(), sizeof(cpuSet), &cpuSet) == 0;
+    }
+  }
+  return false;
+#else
+  (void)aThread;
+  (void)aCoreIndex;
+  return false;
+#endif
+}
+
+//! Lower bound for the acceptor's poll interval (Config::maxIdleWaitTime), so
+//! that an interval of zero doesn't make it spin.
+constexpr auto ACCEPTOR_MIN_POLL_INTERVAL = std::chrono::milliseconds{1};
+
+//! Bounds for the delay before the acceptor retries after a failed poll/accept
+//! (doubled after each consecutive failure).
+constexpr auto ACCEPTOR_MIN_ERROR_BACKOFF = std::chrono::milliseconds{1};
+constexpr auto ACCEPTOR_MAX_ERROR_BACKOFF = std::chrono::milliseconds{1000};
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////
+// TCP SERVER IMPL                                                       //
+///////////////////////////////////////////////////////////////////////////
+
+class TcpServer::Impl {
+public:
+  ~Impl() {
+    stop();
+  }
+
+  EmptyResult start(const Config& aConfig, ConnectionHandler aHandler) {
+    if (_running) {
+      return {ZTCPP_ERROR_REPORT(RuntimeError,
+                                 "Server is already running")};
+    }
+    if (!aHandler) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aHandler is empty")};
+    }
+    if (!aConfig.localIpAddress.isValid()) {
+      return {ZTCPP_ERROR_REPORT(ArgumentError,
+                                 "aConfig.localIpAddress is invalid")};
+    }
+
+    // Set up the listening socket
+    const auto domain = (aConfig.localIpAddress.getAddressFamily() == AddressFamily::IPv4)
+                          ? SocketDomain::InternetProtocol_IPv4
+                          : SocketDomain::InternetProtocol_IPv6;
+    {
+      auto res = _listener.init(domain, SocketType::Stream);
+      if (!res) {
+        return res;
+      }
+    }
+    {
+      auto res = _listener.bind(aConfig.localIpAddress, aConfig.localPort);
+      if (!res) {
+        (void)_listener.close();
+        return res;
+      }
+    }
+    {
+      auto res = _listener.listen(aConfig.backlogSize);
+      if (!res) {
+        (void)_listener.close();
+        return res;
+      }
+    }
+    {
+      auto res = _listener.setNonBlocking(true);
+      if (!res) {
+        (void)_listener.close();
+        return res;
+      }
+    }
+    {
+      auto res = _listener.getLocalPort();
+      _localPort = res ? *res : aConfig.localPort;
+    }
+
+    // Start the threads
+    _handler = std::move(aHandler);
+    _acceptErrorHandler = aConfig.acceptErrorHandler;
+    _acceptorPollInterval = std::max(aConfig.maxIdleWaitTime, ACCEPTOR_MIN_POLL_INTERVAL);
+    _stopRequested.store(false);
+    _accepting.store(true);
+
+    std::size_t workerCount = aConfig.workerCount;
+    if (workerCount == 0) {
+      workerCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    _workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; i += 1) {
+      _workers.push_back(std::make_unique<Worker>(aConfig.maxIdleWaitTime));
+      Worker& worker = *_workers.back();
+      worker.thread = std::thread{[this, &worker]() { runWorker(worker); }};
+      if (aConfig.pinWorkersToCores) {
+        (void)PinThreadToCore(worker.thread, i);
+      }
+    }
+
+    _acceptorThread = std::thread{[this]() { runAcceptor(); }};
+    _running = true;
+
+    return EmptyResultOK();
+  }
+
+  void stop() {
+    if (!_running) {
+      return;
+    }
+
+    _stopRequested.store(true);
+    _acceptorThread.join();
+    for (auto& worker : _workers) {
+      worker->reactor.stop();
+      worker->thread.join();
+    }
+    _workers.clear();
+
+    (void)_listener.close();
+    _handler = nullptr;
+    _acceptErrorHandler = nullptr;
+    _localPort = 0;
+    _accepting.store(false);
+    _running = false;
+  }
+
+  bool isRunning() const {
+    return _running;
+  }
+
+  bool isAccepting() const {
+    return _accepting.load();
+  }
+
+  uint16_t getLocalPort() const {
+    return _localPort;
+  }
+
+  std::size_t getWorkerCount() const {
+    return _workers.size();
+  }
+
+  std::size_t getWorkerLoad(std::size_t aWorkerIndex) const {
+    if (aWorkerIndex >= _workers.size()) {
+      return 0;
+    }
+    return _workers[aWorkerIndex]->load.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Worker {
+    explicit Worker(std::chrono::milliseconds aMaxIdleWaitTime)
+      : reactor{aMaxIdleWaitTime}
+    {
+    }
+
+    Reactor reactor;
+    std::thread thread;
+    std::mutex mutex;
+    std::vector<AcceptedConnection> incoming;   // Protected by mutex
+    std::vector<AcceptedConnection> processing; // Only touched by the worker thread
+    std::atomic<std::size_t> load{0};
+  };
+
+  void runAcceptor() {
+    constexpr int LISTENER_FAILED_EVENTS = PollEventBitmask::HungUp | PollEventBitmask::Error |
+                                           PollEventBitmask::InvalidSocket;
+
+    auto errorBackoff = ACCEPTOR_MIN_ERROR_BACKOFF;
+    while (!_stopRequested.load()) {
+      const auto pollres = _listener.pollEvents(PollEventBitmask::ReadyToAccept,
+                                                _acceptorPollInterval);
+      if (!pollres) {
+        reportAcceptError(pollres.getError());
+        sleepUnlessStopped(errorBackoff);
+        errorBackoff = std::min(errorBackoff * 2, ACCEPTOR_MAX_ERROR_BACKOFF);
+        continue;
+      }
+      if ((*pollres & LISTENER_FAILED_EVENTS) != 0) {
+        reportAcceptError(*ZTCPP_ERROR_REPORT(SocketError,
+                                              "Listening socket failed (poll events=" +
+                                              std::to_string(*pollres) + "); no longer accepting"));
+        break;
+      }
+      if ((*pollres & PollEventBitmask::ReadyToAccept) == 0) {
+        continue;
+      }
+
+      // Drain the whole backlog before polling again
+      const auto acceptres = _listener.acceptMany(_acceptedConnections);
+      for (auto& connection : _acceptedConnections) {
+        dispatchToWorker(std::move(connection));
+      }
+      _acceptedConnections.clear();
+
+      if (!acceptres && !acceptres.wouldBlock()) {
+        reportAcceptError(acceptres.getError());
+        sleepUnlessStopped(errorBackoff);
+        errorBackoff = std::min(errorBackoff * 2, ACCEPTOR_MAX_ERROR_BACKOFF);
+        continue;
+      }
+      errorBackoff = ACCEPTOR_MIN_ERROR_BACKOFF;
+    }
+    _accepting.store(false);
+  }
+
+  void reportAcceptError(const ErrorReport& aError) {
+    if (_acceptErrorHandler) {
+      _acceptErrorHandler(aError);
+    }
+  }
+
+  //! Sleeps for aDuration, but in slices, so that stop() isn't held up.
+  void sleepUnlessStopped(std::chrono::milliseconds aDuration) {
+    const auto deadline = std::chrono::steady_clock::now() + aDuration;
+    while (!_stopRequested.load()) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+        deadline - now, _acceptorPollInterval));
+    }
+  }
+
+  void dispatchToWorker(AcceptedConnection aConnection) {
+    Worker* leastLoaded = nullptr;
+    std::size_t lowestLoad = std::numeric_limits<std::size_t>::max();
+    for (auto& worker : _workers) {
+      const auto load = worker->load.load(std::memory_order_relaxed);
+      if (load < lowestLoad) {
+        lowestLoad = load;
+        leastLoaded = worker.get();
+      }
+    }
+
+    // Count the connection right away so that a burst of connections doesn't all
+    // go to the same worker before it gets a chance to update its load
+    leastLoaded->load.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock{leastLoaded->mutex};
+    leastLoaded->incoming.push_back(std::move(aConnection));
+  }
+
+  void runWorker(Worker& aWorker) {
+    while (!_stopRequested.load()) {
+      {
+        std::lock_guard<std::mutex> lock{aWorker.mutex};
+        std::swap(aWorker.incoming, aWorker.processing);
+      }
+      for (auto& connection : aWorker.processing) {
+        _handler(std::move(connection.socket),
+                 connection.remoteIpAddress,
+                 connection.remotePort,
+                 aWorker.reactor);
+      }
+      aWorker.processing.clear();
+
+      if (!aWorker.reactor.runOnce(std::chrono::milliseconds{-1})) {
+        // Nothing sensible to do about a failed poll except to avoid spinning
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+
+      std::size_t pendingCount;
+      {
+        std::lock_guard<std::mutex> lock{aWorker.mutex};
+        pendingCount = aWorker.incoming.size();
+      }
+      aWorker.load.store(aWorker.reactor.getSocketCount() + pendingCount,
+                         std::memory_order_relaxed);
+    }
+  }
+
+  Socket _listener;
+  std::vector<AcceptedConnection> _acceptedConnections; // Only touched by the acceptor thread
+  uint16_t _localPort = 0;
+  ConnectionHandler _handler;
+  AcceptErrorHandler _acceptErrorHandler;
+  std::chrono::milliseconds _acceptorPollInterval{ACCEPTOR_MIN_POLL_INTERVAL};
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::thread _acceptorThread;
+  std::atomic<bool> _stopRequested{false};
+  std::atomic<bool> _accepting{false};
+  bool _running = false;
+};
+
+///////////////////////////////////////////////////////////////////////////
+// TCP SERVER                                                            //
+///////////////////////////////////////////////////////////////////////////
+
+TcpServer::TcpServer()
+  : _impl{std::make_unique<Impl>()}
+{
+}
+
+TcpServer::~TcpServer() = default;
+
+EmptyResult TcpServer::start(const Config& aConfig, ConnectionHandler aHandler) {
+  return _impl->start(aConfig, std::move(aHandler));
+}
+
+void TcpServer::stop() {
+  _impl->stop();
+}
+
+bool TcpServer::isRunning() const {
+  return _impl->isRunning();
+}
+
+bool TcpServer::isAccepting() const {
+  return _impl->isAccepting();
+}
+
+uint16_t TcpServer::getLocalPort() const {
+  return _impl->getLocalPort();
+}
+
+std::size_t TcpServer::getWorkerCount() const {
+  return _impl->getWorkerCount();
+}
+
+std::size_t TcpServer::getWorkerLoad(std::size_t aWorkerIndex) const {
+  return _impl->getWorkerLoad(aWorkerIndex);
+}
+
+ZTCPP_NAMESPACE_END
@@ -0,0 +1,219 @@
+#include <ZTCpp/Tracing.hpp>
+
+#include "File_util.hpp"
+#include "Tracing_util.hpp"
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+ZTCPP_NAMESPACE_BEGIN
+
+namespace {
+
+#ifdef ZTCPP_ENABLE_TRACING
+std::atomic<TraceHookInterface*> g_traceHook{nullptr};
+#endif
+
+//! Small sequential thread IDs read better in trace viewers than hashed std::thread::ids.
+uint32_t GetTraceThreadID() {
+  static std::atomic<uint32_t> nextThreadID{1};
+  thread_local const uint32_t threadID = nextThreadID.fetch_add(1, std::memory_order_relaxed);
+  return threadID;
+}
+
+int64_t ToNanoseconds(std::chrono::steady_clock::duration aDuration) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(aDuration).count();
+}
+
+//! Append aNanoseconds as microseconds (the unit of the trace event format),
+//! keeping full precision.
+void AppendMicroseconds(std::string& aString, int64_t aNanoseconds) {
+  if (aNanoseconds < 0) {
+    aNanoseconds = 0;
+  }
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%" PRId64 ".%03" PRId64,
+                aNanoseconds / 1000, aNanoseconds % 1000);
+  aString += buffer;
+}
+
+} // namespace
+
+namespace detail {
+
+#ifdef ZTCPP_ENABLE_TRACING
+TraceHookInterface* GetTraceHook() noexcept {
+  return g_traceHook.load(std::memory_order_acquire);
+}
+#endif
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////
+// TRACE HOOK INTERFACE                                                  //
+///////////////////////////////////////////////////////////////////////////
+
+void TraceHookInterface::onCallBegin(const TraceEvent&) {}
+
+///////////////////////////////////////////////////////////////////////////
+// TRACING                                                               //
+///////////////////////////////////////////////////////////////////////////
+
+bool Tracing::isCompiledIn() {
+#ifdef ZTCPP_ENABLE_TRACING
+  return true;
+#else
+  return false;
+#endif
+}
+
+void Tracing::setTraceHook(TraceHookInterface* aHook) {
+#ifdef ZTCPP_ENABLE_TRACING
+  g_traceHook.store(aHook, std::memory_order_release);
+#else
+  (void)aHook;
+#endif
+}
+
+TraceHookInterface* Tracing::getTraceHook() {
+#ifdef ZTCPP_ENABLE_TRACING
+  return detail::GetTraceHook();
+#else
+  return nullptr;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+// CHROME TRACE RECORDER                                                 //
+///////////////////////////////////////////////////////////////////////////
+
+class ChromeTraceRecorder::Impl {
+public:
+  explicit Impl(std::size_t aMaxEventCount)
+    : _origin{std::chrono::steady_clock::now()}
+    , _maxEventCount{aMaxEventCount}
+  {
+  }
+
+  void record(const TraceEvent& aEvent) {
+    const Record record{
+      aEvent.functionName,
+      aEvent.socketID,
+      GetTraceThreadID(),
+      aEvent.requestedByteCount,
+      aEvent.result,
+      ToNanoseconds(aEvent.beginTime - _origin),
+      ToNanoseconds(aEvent.endTime - aEvent.beginTime)
+    };
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (_records.size() >= _maxEventCount) {
+      _droppedEventCount += 1;
+      return;
+    }
+    _records.push_back(record);
+  }
+
+  std::string toString() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    std::string result;
+    result.reserve(64 + _records.size() * 160);
+    result += "{\"traceEvents\":[";
+
+    char buffer[256];
+    for (std::size_t i = 0; i < _records.size(); i += 1) {
+      const auto& record = _records[i];
+
+      result += (i == 0) ? "\n" : ",\n";
+      result += "{\"name\":\"";
+      result += record.functionName;
+      result += "\",\"cat\":\"libzt\",\"ph\":\"X\",\"ts\":";
+      AppendMicroseconds(result, record.beginNanoseconds);
+      result += ",\"dur\":";
+      AppendMicroseconds(result, record.durationNanoseconds);
+      std::snprintf(buffer, sizeof(buffer),
+                    ",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"socket\":%d,"
+                    "\"requestedBytes\":%zu,\"result\":%" PRId64 "}}",
+                    record.threadID, record.socketID,
+                    record.requestedByteCount, record.result);
+      result += buffer;
+    }
+
+    std::snprintf(buffer, sizeof(buffer),
+                  "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":%zu}}\n",
+                  _droppedEventCount);
+    result += buffer;
+    return result;
+  }
+
+  std::size_t getEventCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _records.size();
+  }
+
+  std::size_t getDroppedEventCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _droppedEventCount;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _records.clear();
+    _droppedEventCount = 0;
+  }
+
+private:
+  struct Record {
+    const char* functionName; // Always a string literal
+    int socketID;
+    uint32_t threadID;
+    std::size_t requestedByteCount;
+    int64_t result;
+    int64_t beginNanoseconds;
+    int64_t durationNanoseconds;
+  };
+
+  const std::chrono::steady_clock::time_point _origin;
+  const std::size_t _maxEventCount;
+
+  mutable std::mutex _mutex;
+  std::vector<Record> _records;
+  std::size_t _droppedEventCount = 0;
+};
+
+ChromeTraceRecorder::ChromeTraceRecorder(std::size_t aMaxEventCount)
+  : _impl{std::make_unique<Impl>(aMaxEventCount)}
+{
+}
+
+ChromeTraceRecorder::~ChromeTraceRecorder() = default;
+
+void ChromeTraceRecorder::onCallEnd(const TraceEvent& aEvent) {
+  _impl->record(aEvent);
+}
+
+std::string ChromeTraceRecorder::toString() const {
+  return _impl->toString();
+}
+
+EmptyResult ChromeTraceRecorder::writeToFile(const std::string& aPath) const {
+  return detail::WriteFileAtomically(aPath, toString());
+}
+
+std::size_t ChromeTraceRecorder::getEventCount() const {
+  return _impl->getEventCount();
+}
+
+std::size_t ChromeTraceRecorder::getDroppedEventCount() const {
+  return _impl->getDroppedEventCount();
+}
+
+void ChromeTraceRecorder::clear() {
+  _impl->clear();
+}
+
+ZTCPP_NAMESPACE_END
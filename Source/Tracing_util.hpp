@@ -0,0 +1,66 @@
+#ifndef ZTCPP_TRACING_UTIL_HPP
+#define ZTCPP_TRACING_UTIL_HPP
+
+#include <ZTCpp/Definitions.hpp>
+
+#ifdef ZTCPP_ENABLE_TRACING
+
+#include <ZTCpp/Tracing.hpp>
+
+#include <ZeroTierSockets.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+ZTCPP_NAMESPACE_BEGIN
+namespace detail {
+
+//! Same as Tracing::getTraceHook() (an acquire load, nothing more).
+TraceHookInterface* GetTraceHook() noexcept;
+
+//! Invokes aCall (which makes a single libzt call and returns its result),
+//! reporting it to the current trace hook (if any). zts_errno is preserved across the hook calls.
+template <class taCall>
+auto TracedCall(const char* aFunctionName,
+                int aSocketID,
+                std::size_t aRequestedByteCount,
+                taCall&& aCall) -> decltype(aCall()) {
+  TraceHookInterface* const hook = GetTraceHook();
+  if (hook == nullptr) {
+    return aCall();
+  }
+
+  TraceEvent event{aFunctionName, aSocketID, aRequestedByteCount, {}, {}, 0};
+  hook->onCallBegin(event);
+
+  event.beginTime = std::chrono::steady_clock::now();
+  const auto result = aCall();
+  event.endTime = std::chrono::steady_clock::now();
+  event.result = static_cast<int64_t>(result);
+
+  const int savedErrno = zts_errno;
+  hook->onCallEnd(event);
+  zts_errno = savedErrno;
+
+  return result;
+}
+
+} // namespace detail
+ZTCPP_NAMESPACE_END
+
+//! Evaluates to _call_ (a call into libzt), traced if tracing is compiled in.
+#define ZTCPP_TRACE_CALL(_function_name_, _socket_id_, _requested_byte_count_, _call_) \
+  (::jbatnozic::ztcpp::detail::TracedCall(_function_name_,                            \
+                                          _socket_id_,                                \
+                                          _requested_byte_count_,                     \
+                                          [&]() { return _call_; }))
+
+#else
+
+#define ZTCPP_TRACE_CALL(_function_name_, _socket_id_, _requested_byte_count_, _call_) \
+  (_call_)
+
+#endif // ZTCPP_ENABLE_TRACING
+
+#endif // !ZTCPP_TRACING_UTIL_HPP